@@ -0,0 +1,58 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/include/bench.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <limits>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Keeps the optimizer from throwing away a result. */
+    template <typename T>
+    void keep(T const &t)
+    { asm volatile("" : : "g"(&t) : "memory"); }
+
+    /* Runs f repeatedly for about half a second and reports the fastest
+     * run, along with throughput when the amount of input is known. */
+    template <typename F>
+    void run(std::string const &name, std::size_t const bytes, F &&f)
+    {
+      using clock = std::chrono::steady_clock;
+      double best{ std::numeric_limits<double>::max() };
+      std::size_t runs{};
+      auto const start(clock::now());
+      do
+      {
+        auto const begin(clock::now());
+        f();
+        std::chrono::duration<double> const elapsed{ clock::now() - begin };
+        best = std::min(best, elapsed.count());
+        ++runs;
+      }
+      while(runs < 3 || clock::now() - start < std::chrono::milliseconds{ 500 });
+
+      std::cout << "  " << std::left << std::setw(44) << name
+                << std::right << std::fixed << std::setprecision(3)
+                << std::setw(10) << best * 1000.0 << " ms";
+      if(bytes)
+      {
+        std::cout << std::setprecision(1) << std::setw(10)
+                  << bytes / best / 1e6 << " MB/s";
+      }
+      std::cout << std::endl;
+    }
+  }
+}
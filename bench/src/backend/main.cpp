@@ -0,0 +1,73 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/backend/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <bench.hpp>
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::vector<std::string> keys(std::size_t const n)
+    {
+      std::vector<std::string> out;
+      for(std::size_t k{}; k < n; ++k)
+      { out.push_back("field_" + std::to_string(k * 7919 % (n * 10))); }
+      return out;
+    }
+
+    /* Many objects of the given size, each built and then looked up
+     * key by key, as a parse and then a read would. */
+    template <typename Map>
+    void measure(std::string const &name, std::size_t const size)
+    {
+      std::vector<std::string> const names{ keys(size) };
+      std::size_t const objects{ std::max<std::size_t>(1, 200000 / size) };
+
+      std::vector<Map> maps(objects);
+      run(name + ", build", 0, [&]
+      {
+        for(auto &m : maps)
+        {
+          Map fresh;
+          for(std::size_t k{}; k < size; ++k)
+          { fresh.emplace(names[k], json_value(json_int(k))); }
+          m.swap(fresh);
+        }
+      });
+      run(name + ", lookup", 0, [&]
+      {
+        json_int sum{};
+        for(auto const &m : maps)
+        {
+          for(auto const &k : names)
+          { sum += m.find(k)->second.template as<json_int>(); }
+        }
+        keep(sum);
+      });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  for(std::size_t const size : { 4, 8, 16, 64, 1024 })
+  {
+    std::cout << size << " keys per object, 200k keys in all" << std::endl;
+    measure<std::map<std::string, json_value>>("std::map", size);
+    measure<std::unordered_map<std::string, json_value>>("std::unordered_map", size);
+    measure<jeayeson::flat_map<std::string, json_value>>("flat_map", size);
+  }
+}
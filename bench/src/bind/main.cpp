@@ -0,0 +1,96 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/bind/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    struct order
+    {
+      json_int id{};
+      std::string symbol;
+      double price{};
+      std::vector<json_int> fills;
+      bool open{};
+    };
+
+    /* A batch of about 50 KiB of small messages. */
+    std::string batch()
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 500; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"symbol":"ABCD","price":101.25,"fills":[1,2,3],"open":true})raw";
+      }
+      return json + "]";
+    }
+  }
+
+  template <>
+  struct bind<bench::order>
+  {
+    static auto fields()
+    {
+      return std::make_tuple
+      (
+        field("id", &bench::order::id),
+        field("symbol", &bench::order::symbol),
+        field("price", &bench::order::price),
+        field("fills", &bench::order::fills),
+        field("open", &bench::order::open)
+      );
+    }
+  };
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ batch() };
+
+  std::cout << "bind (" << json.size() << " byte batch)" << std::endl;
+  run("DOM, then copy into structs", json.size(), [&]
+  {
+    json_array const arr{ json_data{ json } };
+    std::vector<order> orders;
+    orders.reserve(arr.size());
+    for(auto const &val : arr)
+    {
+      auto const &m(val.as<json_map>());
+      order o;
+      o.id = m.get<json_int>("id");
+      o.symbol = m.get<std::string>("symbol");
+      o.price = m.get<json_float>("price");
+      for(auto const &fill : m.get<json_array>("fills"))
+      { o.fills.push_back(fill.as<json_int>()); }
+      o.open = m.get<bool>("open");
+      orders.push_back(o);
+    }
+    keep(orders.size());
+  });
+  run("bound structs", json.size(), [&]
+  {
+    auto const orders
+    (jeayeson::read<std::vector<order>>(json_span{ json.data(), json.size() }));
+    keep(orders.size());
+  });
+  std::vector<order> orders;
+  run("bound structs, reused", json.size(), [&]
+  {
+    jeayeson::read(json_span{ json.data(), json.size() }, orders);
+    keep(orders.size());
+  });
+  run("write bound structs", json.size(), [&]
+  { keep(jeayeson::write(orders).size()); });
+}
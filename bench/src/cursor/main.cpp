@@ -0,0 +1,53 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/cursor/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* A request body of about 20 KiB, of which only a few fields are
+     * read. */
+    std::string body()
+    {
+      std::string json{ R"raw({"payload":[)raw" };
+      for(std::size_t i{}; i < 250; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"name":"item","values":[1.5,2.5,3.5],"ok":true})raw";
+      }
+      return json + R"raw(],"route":"/api/v1/items","user":{"id":42}})raw";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ body() };
+
+  std::cout << "cursor (" << json.size() << " byte body)" << std::endl;
+  run("DOM, then read 3 fields", json.size(), [&]
+  {
+    json_map const map{ json };
+    keep(map.get<std::string>("route"));
+    keep(map.get_for_path<json_int>("user.id"));
+    keep(map.get<json_array>("payload").size());
+  });
+  run("cursor reading 3 fields", json.size(), [&]
+  {
+    json_cursor const doc{ json_span{ json.data(), json.size() } };
+    keep(doc.get<std::string>("route"));
+    keep(doc.get_for_path<json_int>("user.id"));
+    keep(doc["payload"].size());
+  });
+}
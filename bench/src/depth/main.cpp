@@ -0,0 +1,60 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/depth/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Many documents nested right up to the depth limit. */
+    std::string deep()
+    {
+      std::size_t const depth{ json_map::parser_t::max_depth - 1 };
+      std::string json{ "[" };
+      for(std::size_t doc{}; doc < 64; ++doc)
+      {
+        json += (doc ? "," : "");
+        for(std::size_t i{}; i < depth; ++i)
+        { json += i % 2 ? "[" : R"raw({"k":)raw"; }
+        json += "0";
+        for(std::size_t i{ depth }; i > 0; --i)
+        { json += (i - 1) % 2 ? "]" : "}"; }
+      }
+      return json + "]";
+    }
+
+    /* One shallow array of many small records. */
+    std::string wide()
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 100000; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"name":"record","tags":["a","b"],"ok":true})raw";
+      }
+      return json + "]";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const deep_json{ deep() };
+  std::string const wide_json{ wide() };
+
+  std::cout << "depth" << std::endl;
+  run("deep (64 x max_depth)", deep_json.size(), [&]
+  { keep(json_array{ json_data{ deep_json } }); });
+  run("wide (100k records)", wide_json.size(), [&]
+  { keep(json_array{ json_data{ wide_json } }); });
+}
@@ -0,0 +1,75 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/file/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* A large dump of records, written out once. */
+    std::size_t write(std::string const &path)
+    {
+      std::ofstream out{ path };
+      out << "[";
+      std::size_t bytes{ 1 };
+      for(std::size_t i{}; i < 500000; ++i)
+      {
+        std::string const record
+        {
+          (i ? "," : "") + std::string{ R"raw({"id":)raw" } +
+          std::to_string(i) +
+          R"raw(,"name":"record","score":12.5,"tags":["a","b","c"]})raw"
+        };
+        out << record;
+        bytes += record.size();
+      }
+      out << "]";
+      return bytes + 1;
+    }
+
+    /* How files used to be loaded, before mapping. */
+    json_array load_ifstream(std::string const &path)
+    {
+      std::string json;
+      std::ifstream infile{ path.c_str() };
+      infile.seekg(0, std::ios_base::end);
+      auto const file_size(infile.tellg());
+      infile.seekg(0, std::ios_base::beg);
+      json.reserve(file_size);
+      std::getline(infile, json, static_cast<char>(-1));
+      return json_array{ json_data{ json } };
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  using jeayeson::detail::file_buffer;
+  std::string const path{ "bin/bench/file.json" };
+  std::size_t const bytes{ write(path) };
+
+  std::cout << "file (500k records)" << std::endl;
+  run("ifstream + getline", bytes, [&]
+  { keep(load_ifstream(path)); });
+  run("buffered read", bytes, [&]
+  {
+    file_buffer const buffer{ path, file_buffer::mode_t::buffered };
+    keep(json_array{ buffer.get() });
+  });
+  run("mmap", bytes, [&]
+  { keep(json_array{ json_file{ path } }); });
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/handler/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::string records()
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 100000; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"name":"record","tags":["a","b"],"ok":true})raw";
+      }
+      return json + "]";
+    }
+
+    /* Sums the ids, allocating nothing. */
+    struct id_sum : json_handler
+    {
+      void key(std::string &k)
+      { is_id = (k == "id"); }
+      void integer(json_int const i)
+      { sum += is_id ? i : 0; }
+
+      bool is_id{};
+      json_int sum{};
+    };
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ records() };
+
+  std::cout << "handler (100k records)" << std::endl;
+  run("DOM, then sum ids", json.size(), [&]
+  {
+    json_array const arr{ json_data{ json } };
+    json_int sum{};
+    for(auto const &r : arr)
+    { sum += r.as<json_map>().get<json_int>("id"); }
+    keep(sum);
+  });
+  run("handler summing ids", json.size(), [&]
+  {
+    id_sum h;
+    jeayeson::parse(json_span{ json.data(), json.size() }, h);
+    keep(h.sum);
+  });
+}
@@ -0,0 +1,93 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/intern/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/interned_key.hpp>
+#include <bench.hpp>
+
+#include <map>
+#include <new>
+#include <vector>
+#include <cstdlib>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::size_t constexpr const records{ 200000 };
+
+    /* Twenty keys, as a typical record might have; some are too long
+     * for SSO. */
+    std::vector<std::string> keys()
+    {
+      std::vector<std::string> out;
+      for(std::size_t k{}; k < 20; ++k)
+      { out.push_back((k % 2 ? "attribute_number_" : "attr_") + std::to_string(k)); }
+      return out;
+    }
+
+    /* Every byte asked for, never decremented. */
+    std::size_t allocated{};
+
+    template <typename Key>
+    void measure(std::string const &name)
+    {
+      using record_t = std::map<Key, json_value>;
+      std::vector<std::string> const names{ keys() };
+
+      std::size_t const before{ allocated };
+      std::vector<record_t> data(records);
+      for(std::size_t i{}; i < records; ++i)
+      {
+        for(std::size_t k{}; k < names.size(); ++k)
+        { data[i].emplace(names[k], static_cast<json_int>(i + k)); }
+      }
+      std::cout << name << " (" << (allocated - before) / (1 << 20)
+                << " MiB allocated for " << records / 1000
+                << "k records)" << std::endl;
+
+      run("lookup, key from a string each time", 0, [&]
+      {
+        json_int sum{};
+        for(auto const &r : data)
+        { sum += r.find(Key{ names[7] })->second.template as<json_int>(); }
+        keep(sum);
+      });
+      Key const key{ names[7] };
+      run("lookup, key made once", 0, [&]
+      {
+        json_int sum{};
+        for(auto const &r : data)
+        { sum += r.find(key)->second.template as<json_int>(); }
+        keep(sum);
+      });
+    }
+  }
+}
+
+/* Not inlined, so the compiler doesn't pair malloc and free with
+ * new and delete at the call sites. */
+__attribute__((noinline)) void* operator new(std::size_t const size)
+{
+  jeayeson::bench::allocated += size;
+  if(void * const p = std::malloc(size ? size : 1))
+  { return p; }
+  throw std::bad_alloc{};
+}
+__attribute__((noinline)) void operator delete(void * const p) noexcept
+{ std::free(p); }
+__attribute__((noinline)) void operator delete(void * const p, std::size_t) noexcept
+{ std::free(p); }
+
+int main()
+{
+  using namespace jeayeson::bench;
+  measure<std::string>("std::string keys");
+  measure<jeayeson::interned_key>("interned_key keys");
+}
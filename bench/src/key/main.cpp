@@ -0,0 +1,114 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/key/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <jeayeson/interned_key.hpp>
+#include <bench.hpp>
+
+#include <map>
+#include <vector>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::size_t constexpr const records{ 200000 };
+
+    /* Twenty keys, as a typical record might have; odd ones are too
+     * long for SSO. The one looked up is among them. */
+    std::vector<std::string> keys()
+    {
+      std::vector<std::string> out;
+      for(std::size_t k{}; k < 19; ++k)
+      { out.push_back((k % 2 ? "attribute_number_" : "attr_") + std::to_string(k)); }
+      out.push_back("timestamp");
+      return out;
+    }
+
+    /* The same key, from every record, three ways: a std::string, a
+     * literal, and a hashed_key made once. */
+    template <typename Map>
+    void measure(std::string const &name)
+    {
+      using key_t = typename Map::key_type;
+      std::vector<std::string> const names{ keys() };
+      std::vector<Map> data(records);
+      for(std::size_t i{}; i < records; ++i)
+      {
+        for(std::size_t k{}; k < names.size(); ++k)
+        { data[i].emplace(key_t(names[k]), json_value(static_cast<json_int>(i + k))); }
+      }
+
+      std::cout << name << std::endl;
+      std::string const str{ "timestamp" };
+      run("std::string", 0, [&]
+      {
+        json_int sum{};
+        for(auto &r : data)
+        {
+          /* Interned keys are interned again; strings aren't copied. */
+          key_t const &k(str);
+          sum += r.find(k)->second.template as<json_int>();
+        }
+        keep(sum);
+      });
+      run("literal", 0, [&]
+      {
+        json_int sum{};
+        for(auto &r : data)
+        { sum += detail::find_key(r, "timestamp")->second.template as<json_int>(); }
+        keep(sum);
+      });
+      hashed_key<key_t> const key{ key_t(str) };
+      run("hashed_key", 0, [&]
+      {
+        json_int sum{};
+        for(auto &r : data)
+        { sum += detail::find_key(r, key)->second.template as<json_int>(); }
+        keep(sum);
+      });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson;
+  using namespace jeayeson::bench;
+  std::cout << records / 1000 << "k records, one lookup each" << std::endl;
+  measure<std::map<std::string, json_value, std::less<>>>("std::map");
+  measure<flat_map<std::string, json_value>>("flat_map");
+  measure<swiss_map<std::string, json_value>>("swiss_map");
+  measure<std::map<interned_key, json_value, std::less<>>>("std::map, interned_key");
+  measure<flat_map<interned_key, json_value>>("flat_map, interned_key");
+  measure<swiss_map<interned_key, json_value>>("swiss_map, interned_key");
+
+  json_map record;
+  std::vector<std::string> const names{ keys() };
+  for(std::size_t k{}; k < names.size(); ++k)
+  { record.set(names[k], static_cast<json_int>(k)); }
+  json_key const key{ "timestamp" };
+  std::cout << "json_map, 1000k lookups" << std::endl;
+  run("get, literal", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < 1000000; ++i)
+    { sum += record.get<json_int>("timestamp"); }
+    keep(sum);
+  });
+  run("get, json_key", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < 1000000; ++i)
+    { sum += record.get<json_int>(key); }
+    keep(sum);
+  });
+}
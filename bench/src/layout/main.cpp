@@ -0,0 +1,92 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/layout/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <vector>
+#include <boost/variant.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Both layouts, holding what a json_value holds. */
+    template <template <typename...> class Variant>
+    using layout = Variant
+    <
+      value::null_t, json_int, json_float, bool, std::string,
+      json_map, json_array, detail::deferred
+    >;
+
+    std::size_t constexpr const count{ 2000000 };
+
+    /* A third each of integers, reals and bools. */
+    template <typename Variant>
+    std::vector<Variant> scalars()
+    {
+      std::vector<Variant> out;
+      out.reserve(count);
+      for(std::size_t i{}; i < count; ++i)
+      {
+        if(i % 3 == 0)
+        { out.emplace_back(static_cast<json_int>(i)); }
+        else if(i % 3 == 1)
+        { out.emplace_back(json_float{ 1.5 }); }
+        else
+        { out.emplace_back(true); }
+      }
+      return out;
+    }
+
+    template <typename Variant>
+    void measure(std::string const &name)
+    {
+      std::cout << name << " (" << sizeof(Variant) << " bytes each, "
+                << (count * sizeof(Variant)) / (1 << 20) << " MiB for "
+                << count / 1000000 << "M scalars)" << std::endl;
+      run("build", 0, [&]{ keep(scalars<Variant>()); });
+
+      std::vector<Variant> const values{ scalars<Variant>() };
+      run("sum", count * sizeof(Variant), [&]
+      {
+        json_float sum{};
+        for(auto const &v : values)
+        {
+          if(auto const * const i = detail::get_if<json_int>(&v))
+          { sum += *i; }
+          else if(auto const * const f = detail::get_if<json_float>(&v))
+          { sum += *f; }
+          else
+          { sum += 1; }
+        }
+        keep(sum);
+      });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  measure<layout<boost::variant>>("boost::variant");
+  measure<layout<jeayeson::compact_variant>>("compact_variant");
+
+  std::string json{ "[" };
+  for(std::size_t i{}; i < count; ++i)
+  { json += (i ? "," : "") + std::string{ i % 3 == 0 ? "42" : i % 3 == 1 ? "1.5" : "true" }; }
+  json += "]";
+  std::cout << "json_array, as configured (" << sizeof(json_value)
+            << " bytes each)" << std::endl;
+  run("parse", json.size(), [&]
+  {
+    json_array const arr{ json_span{ json.data(), json.size() } };
+    keep(arr.size());
+  });
+}
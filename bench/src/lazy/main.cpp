@@ -0,0 +1,69 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/lazy/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <sstream>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* A config of about 1 MiB, mostly in sections which aren't read. */
+    std::string config()
+    {
+      std::string json{ R"raw({"server":{"host":"localhost","port":8080})raw" };
+      for(std::size_t s{}; s < 16; ++s)
+      {
+        json += R"raw(,"section)raw" + std::to_string(s) + R"raw(":[)raw";
+        for(std::size_t i{}; i < 800; ++i)
+        {
+          json += (i ? "," : "");
+          json += R"raw({"id":)raw" + std::to_string(i) +
+                  R"raw(,"name":"entry","weights":[0.25,0.5,0.75],"on":true})raw";
+        }
+        json += "]";
+      }
+      return json + "}";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ config() };
+
+  std::cout << "lazy (" << json.size() << " byte config)" << std::endl;
+  run("eager, then read 1 field", json.size(), [&]
+  {
+    json_map const map{ json_data{ json } };
+    keep(map.get_for_path<json_int>("server.port"));
+  });
+  run("lazy, then read 1 field", json.size(), [&]
+  {
+    json_map const map{ json_data{ json }, json_lazy{} };
+    keep(map.get_for_path<json_int>("server.port"));
+  });
+  run("eager, then write everything", json.size(), [&]
+  {
+    json_map const map{ json_data{ json } };
+    std::ostringstream out;
+    out << map;
+    keep(out.str().size());
+  });
+  run("lazy, then write everything", json.size(), [&]
+  {
+    json_map const map{ json_data{ json }, json_lazy{} };
+    std::ostringstream out;
+    out << map;
+    keep(out.str().size());
+  });
+}
@@ -0,0 +1,58 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/lines/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <thread>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* A log of one record per line. */
+    std::string log()
+    {
+      std::string json;
+      for(std::size_t i{}; i < 200000; ++i)
+      {
+        json += R"raw({"ts":)raw" + std::to_string(1500000000 + i) +
+                R"raw(,"level":"info","msg":"request served","ms":12.5,)raw"
+                R"raw("tags":["http","api"]})raw" "\n";
+      }
+      return json;
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ log() };
+  json_lines const lines{ json_span{ json.data(), json.size() } };
+
+  std::cout << "lines (200k records)" << std::endl;
+  run("json_map per line", json.size(), [&]
+  {
+    std::size_t begin{};
+    while(begin < json.size())
+    {
+      std::size_t const end{ json.find('\n', begin) };
+      keep(json_map{ json.substr(begin, end - begin) });
+      begin = end + 1;
+    }
+  });
+
+  std::size_t const cores{ std::max(1u, std::thread::hardware_concurrency()) };
+  for(std::size_t threads{ 1 }; threads <= cores; threads *= 2)
+  {
+    run("json_lines, " + std::to_string(threads) + " thread(s)", json.size(), [&]
+    { lines.for_each([](json_value const &record){ keep(record); }, threads); });
+  }
+}
@@ -0,0 +1,119 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/lookup/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <bench.hpp>
+
+#include <map>
+#include <vector>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::size_t constexpr const lookups{ 1000000 };
+
+    /* Twenty keys, as a typical record might have; odd ones are too
+     * long for SSO. */
+    std::vector<std::string> keys()
+    {
+      std::vector<std::string> out;
+      for(std::size_t k{}; k < 20; ++k)
+      { out.push_back((k % 2 ? "attribute_number_" : "attr_") + std::to_string(k)); }
+      return out;
+    }
+
+    /* The same lookups straight on a backend: a std::string made for
+     * each, as a literal used to need, and the literal itself. */
+    template <typename Map, typename Find>
+    void measure_backend(std::string const &name, Find &&find)
+    {
+      Map m;
+      std::vector<std::string> const names{ keys() };
+      for(std::size_t k{}; k < names.size(); ++k)
+      { m.emplace(names[k], json_value(static_cast<json_int>(k))); }
+
+      run(name + ", std::string", 0, [&]
+      {
+        json_int sum{};
+        for(std::size_t i{}; i < lookups; ++i)
+        { sum += m.find(std::string{ "attribute_number_17" })->second.template as<json_int>(); }
+        keep(sum);
+      });
+      run(name + ", literal", 0, [&]
+      {
+        json_int sum{};
+        for(std::size_t i{}; i < lookups; ++i)
+        { sum += find(m, "attribute_number_17")->second.template as<json_int>(); }
+        keep(sum);
+      });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+
+  json_map record;
+  std::vector<std::string> const names{ keys() };
+  for(std::size_t k{}; k < names.size(); ++k)
+  { record.set(names[k], json_map{ { "value", json_value(static_cast<json_int>(k)) } }); }
+
+  std::cout << "json_map, " << lookups / 1000 << "k lookups" << std::endl;
+  run("get, std::string made each time", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < lookups; ++i)
+    { sum += record.get<json_map>(std::string{ "attribute_number_17" }).get<json_int>(std::string{ "value" }); }
+    keep(sum);
+  });
+  std::string const long_key{ "attribute_number_17" };
+  std::string const value_key{ "value" };
+  run("get, std::string made ahead of time", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < lookups; ++i)
+    { sum += record.get<json_map>(long_key).get<json_int>(value_key); }
+    keep(sum);
+  });
+  run("get, literal", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < lookups; ++i)
+    { sum += record.get<json_map>("attribute_number_17").get<json_int>("value"); }
+    keep(sum);
+  });
+  run("get_for_path, std::string", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < lookups; ++i)
+    { sum += record.get_for_path<json_int>(std::string{ "attribute_number_17.value" }); }
+    keep(sum);
+  });
+  run("get_for_path, literal", 0, [&]
+  {
+    json_int sum{};
+    for(std::size_t i{}; i < lookups; ++i)
+    { sum += record.get_for_path<json_int>("attribute_number_17.value"); }
+    keep(sum);
+  });
+
+  std::cout << "backends, " << lookups / 1000 << "k lookups" << std::endl;
+  auto const literal([](auto &m, char const * const key)
+  { return m.find(jeayeson::key_view{ key }); });
+  auto const made([](auto &m, char const * const key)
+  { return m.find(std::string{ key }); });
+  measure_backend<std::map<std::string, json_value>>("std::map, std::less<K>", made);
+  measure_backend<std::map<std::string, json_value, std::less<>>>("std::map, std::less<>", literal);
+  measure_backend<jeayeson::flat_map<std::string, json_value>>("flat_map", literal);
+  measure_backend<jeayeson::swiss_map<std::string, json_value>>("swiss_map", literal);
+}
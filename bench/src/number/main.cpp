@@ -0,0 +1,94 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/number/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    template <typename F>
+    std::string numbers(std::size_t const count, F &&gen)
+    {
+      std::mt19937_64 rng{ 42 };
+      std::string json{ "[" };
+      for(std::size_t i{}; i < count; ++i)
+      {
+        json += (i ? "," : "");
+        json += gen(rng);
+      }
+      return json + "]";
+    }
+
+    std::string real(std::mt19937_64 &rng)
+    {
+      char buf[32];
+      std::snprintf
+      (
+        buf, sizeof(buf), "%.17g",
+        std::uniform_real_distribution<double>{ -1e6, 1e6 }(rng)
+      );
+      return buf;
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::size_t const count{ 1000000 };
+  std::string const ints
+  {
+    numbers(count, [](auto &rng)
+    { return std::to_string(static_cast<std::int64_t>(rng())); })
+  };
+  std::string const small_ints
+  {
+    numbers(count, [](auto &rng)
+    { return std::to_string(rng() % 1000); })
+  };
+  std::string const reals{ numbers(count, real) };
+  std::string const short_reals
+  {
+    numbers(count, [](auto &rng)
+    { return std::to_string(rng() % 10000) + "." + std::to_string(rng() % 100); })
+  };
+
+  std::cout << "number (" << count << " per array)" << std::endl;
+  run("int64 array", ints.size(), [&]
+  { keep(json_array{ json_data{ ints } }); });
+  run("small int array", small_ints.size(), [&]
+  { keep(json_array{ json_data{ small_ints } }); });
+  run("double array (17 digits)", reals.size(), [&]
+  { keep(json_array{ json_data{ reals } }); });
+  run("double array (short)", short_reals.size(), [&]
+  { keep(json_array{ json_data{ short_reals } }); });
+
+  /* The number engine alone, against the C library. */
+  run("parse_number (17 digits)", reals.size(), [&]
+  {
+    jeayeson::detail::number num;
+    char const *it{ reals.data() + 1 };
+    char const * const end{ reals.data() + reals.size() };
+    while(it < end)
+    { it = jeayeson::detail::parse_number(it, end, num) + 1; keep(num); }
+  });
+  run("std::strtod (17 digits)", reals.size(), [&]
+  {
+    char *it{ const_cast<char*>(reals.data()) + 1 };
+    char const * const end{ reals.data() + reals.size() };
+    while(it < end)
+    { double const d{ std::strtod(it, &it) }; keep(d); ++it; }
+  });
+}
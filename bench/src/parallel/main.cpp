@@ -0,0 +1,50 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/parallel/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <thread>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* One huge top-level array of records. */
+    std::string huge()
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 300000; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"name":"record","score":12.5,"tags":["a","b"],"ok":true})raw";
+      }
+      return json + "]";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ huge() };
+  json_span const input{ json.data(), json.size() };
+
+  std::cout << "parallel (300k element array)" << std::endl;
+  run("serial", json.size(), [&]
+  { keep(json_array{ input }); });
+
+  std::size_t const cores{ std::max(1u, std::thread::hardware_concurrency()) };
+  for(std::size_t threads{ 1 }; threads <= cores; threads *= 2)
+  {
+    run("parallel, " + std::to_string(threads) + " thread(s)", json.size(), [&]
+    { keep(json_array{ input, json_parallel{ threads } }); });
+  }
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/projection/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* A wide record of 200 keys, of which 5 are read. */
+    std::string record()
+    {
+      std::string json{ R"raw({"user":{"id":42,"name":"jeaye"},"ts":1234567890)raw" };
+      for(std::size_t i{}; i < 197; ++i)
+      {
+        json += R"raw(,"field_)raw" + std::to_string(i) + "\":";
+        switch(i % 3)
+        {
+          case 0: json += R"raw("some \"quoted\" value")raw"; break;
+          case 1: json += std::to_string(i * 1.5); break;
+          case 2: json += R"raw({"nested":[1,2,3],"flag":false})raw"; break;
+        }
+      }
+      return json + R"raw(,"country":"NZ","score":0.75})raw";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const json{ record() };
+  json_projection const paths
+  { { "user.id", "user.name", "ts", "country", "score" } };
+
+  std::cout << "projection (" << json.size() << " byte record)" << std::endl;
+  run("full record", json.size(), [&]
+  {
+    json_map const map{ json_data{ json } };
+    keep(map.get_for_path<json_int>("user.id"));
+  });
+  run("5 paths", json.size(), [&]
+  {
+    json_map const map{ json_span{ json.data(), json.size() }, paths };
+    keep(map.get_for_path<json_int>("user.id"));
+  });
+}
@@ -0,0 +1,69 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/reuse/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <vector>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Many small messages, as from a socket. */
+    std::vector<std::string> messages()
+    {
+      std::vector<std::string> out;
+      for(std::size_t i{}; i < 100000; ++i)
+      {
+        out.push_back
+        (
+          R"raw({"id":)raw" + std::to_string(i) +
+          R"raw(,"op":"update","fields":{"price":12.5,"qty":3},"tags":["a","b"]})raw"
+        );
+      }
+      return out;
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::vector<std::string> const msgs{ messages() };
+  std::size_t bytes{};
+  for(auto const &msg : msgs)
+  { bytes += msg.size(); }
+
+  std::cout << "reuse (100k messages)" << std::endl;
+  run("json_map per message", bytes, [&]
+  {
+    for(auto const &msg : msgs)
+    { keep(json_map{ json_span{ msg.data(), msg.size() } }); }
+  });
+  run("json_map reset", bytes, [&]
+  {
+    json_map out;
+    for(auto const &msg : msgs)
+    {
+      out.reset(json_span{ msg.data(), msg.size() });
+      keep(out);
+    }
+  });
+  run("json_parser", bytes, [&]
+  {
+    json_parser p;
+    json_map out;
+    for(auto const &msg : msgs)
+    {
+      p.parse(json_span{ msg.data(), msg.size() }, out);
+      keep(out);
+    }
+  });
+}
@@ -0,0 +1,46 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/string/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Records with one long string field, like log lines or base64. */
+    std::string strings(std::size_t const length, std::string const &escape)
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 10000; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"message":")raw" + std::string(length / 2, 'a') +
+                escape + std::string(length / 2, 'b') + R"raw("})raw";
+      }
+      return json + "]";
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string const short_json{ strings(16, "") };
+  std::string const long_json{ strings(1024, "") };
+  std::string const escaped_json{ strings(1024, R"raw(\n\"©)raw") };
+
+  std::cout << "string (10000 records)" << std::endl;
+  run("short strings (16 bytes)", short_json.size(), [&]
+  { keep(json_array{ json_data{ short_json } }); });
+  run("long strings (1 KiB)", long_json.size(), [&]
+  { keep(json_array{ json_data{ long_json } }); });
+  run("long strings with escapes (1 KiB)", escaped_json.size(), [&]
+  { keep(json_array{ json_data{ escaped_json } }); });
+}
@@ -0,0 +1,87 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/swiss/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <bench.hpp>
+
+#include <map>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    std::vector<std::string> keys(std::size_t const n, std::string const &prefix)
+    {
+      std::vector<std::string> out;
+      for(std::size_t k{}; k < n; ++k)
+      { out.push_back(prefix + std::to_string(k * 7919 % (n * 10))); }
+      return out;
+    }
+
+    /* Lookups don't follow insertion order, which would favor maps
+     * that allocate entries in that order. */
+    std::vector<std::string> shuffled(std::vector<std::string> out)
+    {
+      std::shuffle(out.begin(), out.end(), std::mt19937{ 42 });
+      return out;
+    }
+
+    /* One object with the given number of keys: inserting them all,
+     * then looking up each one, then looking up as many missing ones. */
+    template <typename Map>
+    void measure(std::string const &name, std::size_t const size)
+    {
+      std::vector<std::string> const names{ keys(size, "field_") };
+      std::vector<std::string> const present{ shuffled(names) };
+      std::vector<std::string> const missing{ keys(size, "absent_") };
+
+      Map m;
+      run(name + ", insert", 0, [&]
+      {
+        Map fresh;
+        for(std::size_t k{}; k < size; ++k)
+        { fresh.emplace(names[k], json_value(json_int(k))); }
+        m.swap(fresh);
+      });
+      run(name + ", lookup hit", 0, [&]
+      {
+        json_int sum{};
+        for(auto const &k : present)
+        { sum += m.find(k)->second.template as<json_int>(); }
+        keep(sum);
+      });
+      run(name + ", lookup miss", 0, [&]
+      {
+        std::size_t found{};
+        for(auto const &k : missing)
+        { found += m.find(k) != m.end(); }
+        keep(found);
+      });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  for(std::size_t const size : { 1000, 10000, 100000, 1000000 })
+  {
+    std::cout << size << " keys in one object" << std::endl;
+    measure<std::map<std::string, json_value>>("std::map", size);
+    measure<std::unordered_map<std::string, json_value>>("std::unordered_map", size);
+    measure<jeayeson::flat_map<std::string, json_value>>("flat_map", size);
+    measure<jeayeson::swiss_map<std::string, json_value>>("swiss_map", size);
+  }
+}
@@ -0,0 +1,87 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/utf/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <boost/locale.hpp>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* Records of text written with every non-ASCII character escaped,
+     * as many serializers do by default. */
+    std::string escaped(std::string const &text)
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; i < 5000; ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"text":")raw" + text + R"raw("})raw";
+      }
+      return json + "]";
+    }
+
+    /* The decoder as it was, through a std::u16string and boost::locale,
+     * for comparison. */
+    int hex_to_num(char const c)
+    {
+      if(c >= '0' && c <= '9')
+      { return c - '0'; }
+      else if(c >= 'a' && c <= 'f')
+      { return c - 'a' + 10; }
+      else if(c >= 'A' && c <= 'F')
+      { return c - 'A' + 10; }
+      return -1;
+    }
+    std::string boost_utf16_to_8(char const *it, char const * const end)
+    {
+      std::u16string u16;
+      for( ; end - it > 5 && std::equal(it, it + 2, "\\u"); it += 6)
+      {
+        u16.push_back
+        (
+          (hex_to_num(it[2]) << 12) + (hex_to_num(it[3]) << 8) +
+          (hex_to_num(it[4]) << 4) + hex_to_num(it[5])
+        );
+      }
+      return boost::locale::conv::utf_to_utf<char>(u16);
+    }
+
+    void measure(std::string const &name, std::string const &text)
+    {
+      std::string const json{ escaped(text) };
+      std::cout << name << " (" << json.size() << " bytes)" << std::endl;
+      run("decode with boost::locale", text.size(), [&]
+      { keep(boost_utf16_to_8(text.data(), text.data() + text.size())); });
+      run("decode", text.size(), [&]
+      {
+        std::string out;
+        detail::utf16_to_8(text.data(), text.data() + text.size(), out);
+        keep(out);
+      });
+      run("parse", json.size(), [&]
+      { keep(json_array{ json_data{ json } }); });
+    }
+  }
+}
+
+int main()
+{
+  using namespace jeayeson::bench;
+  std::string cjk, emoji;
+  for(std::size_t i{}; i < 40; ++i)
+  {
+    cjk += R"raw(\u6771\u4eac\u90fd\u306e\u5929\u6c17)raw";
+    emoji += R"raw(\ud83d\ude0a\ud83c\udf89)raw";
+  }
+  measure("cjk", cjk);
+  measure("emoji", emoji);
+}
@@ -0,0 +1,67 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bench/src/validate/main.cpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <bench.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace jeayeson
+{
+  namespace bench
+  {
+    /* About 1 MiB of records, with the given text in each. */
+    std::string corpus(std::string const &text)
+    {
+      std::string json{ "[" };
+      for(std::size_t i{}; json.size() < (1 << 20); ++i)
+      {
+        json += (i ? "," : "");
+        json += R"raw({"id":)raw" + std::to_string(i) +
+                R"raw(,"text":")raw" + text + R"raw(","score":0.5})raw";
+      }
+      return json + "]";
+    }
+
+    void measure(std::string const &name, std::string const &json)
+    {
+      std::cout << name << " (" << json.size() << " bytes)" << std::endl;
+      run("check only", json.size(), [&]
+      { keep(detail::is_utf8(json.data(), json.size())); });
+      run("parse", json.size(), [&]
+      {
+        json_array const arr{ json_span{ json.data(), json.size() } };
+        keep(arr.size());
+      });
+      run("parse, validating", json.size(), [&]
+      {
+        json_array const arr{ json_span{ json.data(), json.size() }, json_validate{} };
+        keep(arr.size());
+      });
+    }
+  }
+}
+
+/* Any files given are measured, too; each must be a JSON array. */
+int main(int const argc, char const * const * const argv)
+{
+  using namespace jeayeson::bench;
+  measure("ascii", corpus("The quick brown fox jumps over the lazy dog."));
+  measure("latin", corpus("Fête, façade, naïve, señor, Zürich, smørrebrød."));
+  measure("cjk", corpus("東京都の天気は晴れ、最高気温は二十五度です。"));
+
+  for(int i{ 1 }; i < argc; ++i)
+  {
+    std::ifstream file{ argv[i] };
+    std::stringstream ss;
+    ss << file.rdbuf();
+    measure(argv[i], ss.str());
+  }
+}
@@ -0,0 +1,194 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: arena.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace jeayeson
+{
+  /* Hands out memory from large blocks, and only gives it back all at
+   * once, in release. While a scope is open on a thread, everything
+   * built there with an arena_allocator comes from that arena:
+   *
+   *   jeayeson::arena a;
+   *   {
+   *     jeayeson::arena::scope const s{ a };
+   *     json_map const doc{ json_data{ body } };
+   *     ...
+   *   }
+   *   a.release();
+   *
+   * Nothing allocated from an arena may outlive its release. An arena
+   * isn't safe to use from several threads at once. */
+  class arena
+  {
+    public:
+      class scope;
+
+      explicit arena(std::size_t const block_size = 64 * 1024)
+        : block_size_{ block_size }
+      { }
+      arena(arena const &) = delete;
+      arena& operator =(arena const &) = delete;
+      ~arena()
+      { release(); }
+
+      void* allocate(std::size_t const size, std::size_t const align)
+      {
+        std::uintptr_t const aligned
+        { (reinterpret_cast<std::uintptr_t>(next_) + align - 1) & ~(align - 1) };
+        if(!head_ || aligned + size > reinterpret_cast<std::uintptr_t>(end_))
+        { return grow(size, align); }
+
+        next_ = reinterpret_cast<char*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+      }
+
+      /* Frees every block. */
+      void release()
+      {
+        while(head_)
+        {
+          block * const next{ head_->next };
+          ::operator delete(head_);
+          head_ = next;
+        }
+        next_ = end_ = nullptr;
+        reserved_ = 0;
+      }
+
+      /* The bytes held in blocks, used or not. */
+      std::size_t reserved() const
+      { return reserved_; }
+
+      /* The arena of the innermost open scope on this thread, if any. */
+      static arena*& current()
+      {
+        static thread_local arena *a{};
+        return a;
+      }
+
+    private:
+      struct block
+      {
+        block *next;
+      };
+
+      /* Requests bigger than a block get a block to themselves, so the
+       * rest of the current block isn't wasted. */
+      void* grow(std::size_t const size, std::size_t const align)
+      {
+        std::size_t const needed{ sizeof(block) + size + align };
+        bool const alone{ needed > block_size_ / 2 };
+        std::size_t const bytes{ alone ? needed : block_size_ };
+
+        block * const b{ static_cast<block*>(::operator new(bytes)) };
+        reserved_ += bytes;
+        char * const begin{ reinterpret_cast<char*>(b + 1) };
+        std::uintptr_t const aligned
+        { (reinterpret_cast<std::uintptr_t>(begin) + align - 1) & ~(align - 1) };
+
+        if(alone && head_)
+        {
+          b->next = head_->next;
+          head_->next = b;
+        }
+        else
+        {
+          b->next = head_;
+          head_ = b;
+          next_ = reinterpret_cast<char*>(aligned + size);
+          end_ = reinterpret_cast<char*>(b) + bytes;
+        }
+        return reinterpret_cast<void*>(aligned);
+      }
+
+      std::size_t const block_size_;
+      block *head_{};
+      char *next_{};
+      char *end_{};
+      std::size_t reserved_{};
+  };
+
+  /* Makes an arena current on this thread until it ends; scopes nest. */
+  class arena::scope
+  {
+    public:
+      explicit scope(arena &a)
+        : previous_{ current() }
+      { current() = &a; }
+      scope(scope const &) = delete;
+      scope& operator =(scope const &) = delete;
+      ~scope()
+      { current() = previous_; }
+
+    private:
+      arena * const previous_;
+  };
+
+  /* Takes its arena from the open scope when it's made, or uses the
+   * heap if there isn't one. Containers keep their allocator when
+   * moved or swapped, so a document built in an arena stays in it.
+   * Copies use the scope open where they're made. To put documents in
+   * an arena, use this as allocator_t in config.hpp. */
+  template <typename T>
+  class arena_allocator
+  {
+    public:
+      using value_type = T;
+      using propagate_on_container_copy_assignment = std::false_type;
+      using propagate_on_container_move_assignment = std::true_type;
+      using propagate_on_container_swap = std::true_type;
+
+      arena_allocator() noexcept
+        : arena_{ arena::current() }
+      { }
+      template <typename U>
+      arena_allocator(arena_allocator<U> const &other) noexcept
+        : arena_{ other.arena_ }
+      { }
+
+      T* allocate(std::size_t const n)
+      {
+        if(arena_)
+        { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+      }
+      /* Arena memory is only given back by release. */
+      void deallocate(T * const p, std::size_t const) noexcept
+      {
+        if(!arena_)
+        { ::operator delete(p); }
+      }
+
+      arena_allocator select_on_container_copy_construction() const
+      { return {}; }
+
+      template <typename U>
+      friend class arena_allocator;
+      template <typename L, typename R>
+      friend bool operator ==
+      (arena_allocator<L> const &lhs, arena_allocator<R> const &rhs);
+
+    private:
+      arena *arena_;
+  };
+
+  template <typename L, typename R>
+  bool operator ==(arena_allocator<L> const &lhs, arena_allocator<R> const &rhs)
+  { return lhs.arena_ == rhs.arena_; }
+  template <typename L, typename R>
+  bool operator !=(arena_allocator<L> const &lhs, arena_allocator<R> const &rhs)
+  { return !(lhs == rhs); }
+}
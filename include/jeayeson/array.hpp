@@ -18,7 +18,12 @@
 #include <initializer_list>
 
 #include "detail/normalize.hpp"
+#include "detail/config.hpp"
 #include "file.hpp"
+#include "span.hpp"
+#include "parallel.hpp"
+#include "lazy.hpp"
+#include "validate.hpp"
 
 namespace jeayeson
 {
@@ -38,7 +43,7 @@ namespace jeayeson
       using parser_t = Parser;
       using index_t = uint32_t;
       using key_t = std::string;
-      using internal_array_t = std::vector<Value>;
+      using internal_array_t = std::vector<Value, detail::allocator<Value>>;
       using iterator = typename internal_array_t::iterator;
       using const_iterator = typename internal_array_t::const_iterator;
 
@@ -47,13 +52,37 @@ namespace jeayeson
       static char const delim_close = ']';
 
       array(){} /* XXX: User-defined ctor required for variant. */
-      array(array const &arr)
-        : values_{ arr.values_ }
-      { }
+      array(array const &) = default;
+      array(array &&) noexcept = default;
+      array& operator =(array const &) = default;
+      array& operator =(array &&) noexcept = default;
       array(data const &json)
       { reset(json); }
       array(file const &f)
       { reset(f); }
+      array(span const &json)
+      { reset(json); }
+      /* The elements are parsed across threads. */
+      array(data const &json, parallel const &p)
+      { reset(json, p); }
+      array(span const &json, parallel const &p)
+      { reset(json, p); }
+      array(file const &f, parallel const &p)
+      { reset(f, p); }
+      /* Invalid UTF-8 in the input throws. */
+      array(data const &json, validate const &v)
+      { reset(json, v); }
+      array(span const &json, validate const &v)
+      { reset(json, v); }
+      array(file const &f, validate const &v)
+      { reset(f, v); }
+      /* Nested maps and arrays are parsed when first touched. */
+      array(data const &json, lazy const &l)
+      { reset(json, l); }
+      array(span const &json, lazy const &l)
+      { reset(json, l); }
+      array(file const &f, lazy const &l)
+      { reset(f, l); }
 
       template
       <
@@ -152,6 +181,8 @@ namespace jeayeson
 
       void reserve(size_t const size)
       { values_.reserve(size); }
+      void resize(size_t const size)
+      { values_.resize(size); }
 
       void reset(data const &json)
       { *this = Parser::template parse<array_t>(json.data); }
@@ -159,6 +190,26 @@ namespace jeayeson
       { *this = Parser::template parse<array_t>(json); }
       void reset(file const &f)
       { *this = Parser::template parse<array_t>(f); }
+      void reset(span const &json)
+      { *this = Parser::template parse<array_t>(json); }
+      void reset(data const &json, parallel const &p)
+      { reset(span{ json.data.data(), json.data.size() }, p); }
+      void reset(span const &json, parallel const &p)
+      { *this = Parser::template parse<array_t>(json, p); }
+      void reset(file const &f, parallel const &p)
+      { *this = Parser::template parse<array_t>(f, p); }
+      void reset(data const &json, validate const &v)
+      { *this = Parser::template parse<array_t>(json, v); }
+      void reset(span const &json, validate const &v)
+      { *this = Parser::template parse<array_t>(json, v); }
+      void reset(file const &f, validate const &v)
+      { *this = Parser::template parse<array_t>(f, v); }
+      void reset(data const &json, lazy const &l)
+      { *this = Parser::template parse<array_t>(json, l); }
+      void reset(span const &json, lazy const &l)
+      { *this = Parser::template parse<array_t>(json, l); }
+      void reset(file const &f, lazy const &l)
+      { *this = Parser::template parse<array_t>(f, l); }
 
       std::string to_string() const
       { return Parser::template save<array_t>(*this); }
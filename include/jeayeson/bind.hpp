@@ -0,0 +1,407 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: bind.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <map>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include "value.hpp"
+#include "detail/document.hpp"
+#include "detail/number.hpp"
+#include "detail/escape.hpp"
+
+namespace jeayeson
+{
+  /* Specialize this to read and write a struct directly, without a
+   * json_value in between:
+   *
+   *   template <>
+   *   struct bind<point>
+   *   {
+   *     static auto fields()
+   *     { return std::make_tuple(field("x", &point::x), field("y", &point::y)); }
+   *   };
+   *
+   * Members may be numbers, bools, strings, json_values, other bound
+   * structs, or std::vectors, std::maps and boost::optionals of those. */
+  template <typename T>
+  struct bind;
+
+  namespace detail
+  {
+    template <typename T, typename Member>
+    struct field
+    {
+      char const *name;
+      std::size_t size;
+      Member T::*member;
+    };
+
+    template <typename T, typename E = void>
+    struct is_bound : std::false_type
+    { };
+    template <typename T>
+    struct is_bound<T, decltype(void(bind<T>::fields()))> : std::true_type
+    { };
+
+    template <typename Tuple, typename F, std::size_t... Ns>
+    void for_each_field(Tuple const &t, F &&f, std::index_sequence<Ns...>)
+    {
+      int const expand[]{ 0, (f(std::get<Ns>(t)), 0)... };
+      static_cast<void>(expand);
+    }
+    template <typename Tuple, typename F>
+    void for_each_field(Tuple const &t, F &&f)
+    {
+      for_each_field
+      (t, f, std::make_index_sequence<std::tuple_size<Tuple>::value>{});
+    }
+
+    /* Fills a bound type straight from the structural index. Keys with
+     * no matching field are skipped by matching brackets, without
+     * anything in them being decoded. Fields missing from the input
+     * are left as they were. */
+    class bind_reader
+    {
+      public:
+        explicit bind_reader(document const &doc)
+          : doc_(doc)
+        { }
+
+        template <typename T>
+        void read(T &out)
+        {
+          for(j_ = 0; j_ < doc_.count(); ++j_)
+          {
+            char const c{ doc_.at(j_) };
+            if(c != ',' && c != ':')
+            {
+              read_value(out);
+              return;
+            }
+          }
+        }
+
+      private:
+        void fail(char const * const name) const
+        {
+          throw std::runtime_error
+          { std::string{ "invalid value type; required " } + name };
+        }
+
+        void open(char const delim, char const * const name)
+        {
+          if(doc_.at(j_) != delim)
+          { fail(name); }
+          if(++depth_ > parser::max_depth)
+          {
+            throw std::runtime_error
+            { "exceeded max parse depth: " + std::to_string(parser::max_depth) };
+          }
+          ++j_;
+        }
+
+        /* Steps over separators; false, and past it, at the close. */
+        bool next(char const delim)
+        {
+          while(true)
+          {
+            char const c{ doc_.at(j_) };
+            if(c == delim)
+            {
+              ++j_;
+              --depth_;
+              return false;
+            }
+            else if(c == ',')
+            { ++j_; }
+            else if(c == '\0')
+            { throw std::runtime_error{ "unexpected end of input" }; }
+            else
+            { return true; }
+          }
+        }
+
+        number read_number(char const * const name)
+        {
+          char const c{ doc_.at(j_) };
+          if(c != '-' && (c < '0' || c > '9'))
+          { fail(name); }
+          number num;
+          parse_number(doc_.text(j_), doc_.end(), num);
+          ++j_;
+          return num;
+        }
+
+        void read_value(std::string &out)
+        {
+          if(doc_.at(j_) != '"')
+          { fail("string"); }
+          out.clear();
+          parse_string(doc_.text(j_) + 1, doc_.text(j_ + 1), out);
+          j_ += 2;
+        }
+
+        void read_value(bool &out)
+        {
+          char const c{ doc_.at(j_) };
+          if(c != 't' && c != 'f')
+          { fail("boolean"); }
+          out = (c == 't');
+          ++j_;
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_integral<T>::value> read_value(T &out)
+        {
+          number const num{ read_number("integer") };
+          if(num.is_real || !fits<T>(num.integer))
+          { fail("integer"); }
+          out = static_cast<T>(num.integer);
+        }
+
+        template <typename T, typename Int>
+        static bool fits(Int const n)
+        {
+          using limits = std::numeric_limits<T>;
+          if(n < 0)
+          { return limits::is_signed && n >= static_cast<Int>(limits::min()); }
+          return static_cast<std::uintmax_t>(n) <=
+                 static_cast<std::uintmax_t>(limits::max());
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_floating_point<T>::value> read_value(T &out)
+        {
+          number const num{ read_number("real") };
+          out = static_cast<T>(num.is_real ? num.real : num.integer);
+        }
+
+        void read_value(value &out)
+        {
+          if(!starts_value(doc_.at(j_)))
+          { fail("value"); }
+          builder<value, parser> b{ out };
+          j_ = parser::parse(b, doc_.json.data, doc_.json.size, doc_.index, j_);
+        }
+
+        template <typename T>
+        void read_value(boost::optional<T> &out)
+        {
+          if(doc_.at(j_) == 'n')
+          {
+            out = boost::none;
+            ++j_;
+            return;
+          }
+          out = T{};
+          read_value(*out);
+        }
+
+        template <typename T, typename Alloc>
+        void read_value(std::vector<T, Alloc> &out)
+        {
+          open('[', "array");
+          out.clear();
+          while(next(']'))
+          {
+            out.emplace_back();
+            read_value(out.back());
+          }
+        }
+
+        template <typename T, typename Compare, typename Alloc>
+        void read_value(std::map<std::string, T, Compare, Alloc> &out)
+        {
+          open('{', "map");
+          out.clear();
+          std::string key;
+          while(next('}'))
+          {
+            read_value(key);
+            ++j_; /* The colon. */
+            read_value(out[key]);
+          }
+        }
+
+        template <typename T>
+        std::enable_if_t<is_bound<T>::value> read_value(T &out)
+        {
+          open('{', "map");
+          while(next('}'))
+          {
+            if(doc_.at(j_) != '"')
+            { fail("string"); }
+            std::size_t const key{ j_ };
+            j_ += 3; /* The key's quotes, then the colon. */
+
+            bool found{};
+            for_each_field(bind<T>::fields(), [&](auto const &f)
+            {
+              if(!found && doc_.equals(key, f.name, f.size))
+              {
+                found = true;
+                read_value(out.*(f.member));
+              }
+            });
+            if(!found)
+            { j_ = doc_.skip(j_); }
+          }
+        }
+
+        document const &doc_;
+        std::size_t j_{};
+        std::size_t depth_{};
+    };
+
+    /* The mirror of bind_reader; the output reads back the same. */
+    class bind_writer
+    {
+      public:
+        explicit bind_writer(std::ostream &stream)
+          : stream_(stream)
+        { }
+
+        void write(std::string const &str)
+        { stream_ << "\"" << escape(str) << "\""; }
+        void write(bool const b)
+        { stream_ << (b ? "true" : "false"); }
+        /* Promoted, so chars are written as numbers. */
+        template <typename T>
+        std::enable_if_t<std::is_integral<T>::value> write(T const n)
+        { stream_ << +n; }
+        /* Enough digits to read back the same value. */
+        template <typename T>
+        std::enable_if_t<std::is_floating_point<T>::value> write(T const n)
+        {
+          if(!std::isfinite(n))
+          { throw std::runtime_error{ "invalid value; numbers must be finite" }; }
+          auto const precision
+          (stream_.precision(std::numeric_limits<T>::max_digits10));
+          stream_ << n;
+          stream_.precision(precision);
+        }
+        void write(value const &val)
+        { stream_ << val; }
+
+        template <typename T>
+        void write(boost::optional<T> const &opt)
+        {
+          if(opt)
+          { write(*opt); }
+          else
+          { stream_ << "null"; }
+        }
+
+        template <typename T, typename Alloc>
+        void write(std::vector<T, Alloc> const &arr)
+        {
+          stream_ << '[';
+          for(auto it(arr.begin()); it != arr.end(); ++it)
+          {
+            if(it != arr.begin())
+            { stream_ << ','; }
+            write(*it);
+          }
+          stream_ << ']';
+        }
+
+        template <typename T, typename Compare, typename Alloc>
+        void write(std::map<std::string, T, Compare, Alloc> const &m)
+        {
+          stream_ << '{';
+          for(auto it(m.begin()); it != m.end(); ++it)
+          {
+            if(it != m.begin())
+            { stream_ << ','; }
+            write(it->first);
+            stream_ << ':';
+            write(it->second);
+          }
+          stream_ << '}';
+        }
+
+        template <typename T>
+        std::enable_if_t<is_bound<T>::value> write(T const &t)
+        {
+          stream_ << '{';
+          bool first{ true };
+          for_each_field(bind<T>::fields(), [&](auto const &f)
+          {
+            if(!first)
+            { stream_ << ','; }
+            first = false;
+            write(std::string{ f.name, f.size });
+            stream_ << ':';
+            write(t.*(f.member));
+          });
+          stream_ << '}';
+        }
+
+      private:
+        std::ostream &stream_;
+    };
+  }
+
+  /* Names a member of a bound struct; see bind. */
+  template <typename T, typename Member, std::size_t N>
+  detail::field<T, Member> field(char const (&name)[N], Member T::*member)
+  { return { name, N - 1, member }; }
+
+  /* Parses into a bound type, or any type a bound struct's members may
+   * be, without building a json_value. Reading into an existing object
+   * keeps the storage of its vectors and strings. */
+  template <typename T>
+  void read(span const &json, T &out)
+  {
+    detail::document const doc{ json };
+    detail::bind_reader{ doc }.read(out);
+  }
+  template <typename T>
+  void read(data const &json, T &out)
+  { read(span{ json.data.data(), json.data.size() }, out); }
+  template <typename T>
+  void read(file const &f, T &out)
+  {
+    detail::document const doc{ f };
+    detail::bind_reader{ doc }.read(out);
+  }
+
+  template <typename T, typename Input>
+  T read(Input const &json)
+  {
+    T out{};
+    read(json, out);
+    return out;
+  }
+
+  template <typename T>
+  void write(std::ostream &stream, T const &t)
+  { detail::bind_writer{ stream }.write(t); }
+  template <typename T>
+  std::string write(T const &t)
+  {
+    std::ostringstream stream;
+    write(stream, t);
+    return stream.str();
+  }
+}
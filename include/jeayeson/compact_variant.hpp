@@ -0,0 +1,248 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: compact_variant.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <new>
+#include <tuple>
+#include <ostream>
+#include <utility>
+#include <cstring>
+#include <type_traits>
+
+#include <boost/variant/get.hpp>
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* See detail/box.hpp, which needs config's allocator_t. */
+    template <typename T>
+    class box;
+
+    /* The position of T within Ts, or sizeof...(Ts) if it isn't there. */
+    template <typename T, typename... Ts>
+    constexpr std::size_t index_of()
+    {
+      bool const same[]{ false, std::is_same<T, Ts>::value... };
+      for(std::size_t i{ 1 }; i < sizeof(same); ++i)
+      {
+        if(same[i])
+        { return i - 1; }
+      }
+      return sizeof...(Ts);
+    }
+
+    /* Small, trivial types are held within the variant; the rest are
+     * held in a box, from config's allocator_t. */
+    template <typename T>
+    constexpr bool fits_inline()
+    {
+      return sizeof(T) <= sizeof(void*) && alignof(T) <= alignof(void*) &&
+             std::is_trivially_copyable<T>::value;
+    }
+  }
+
+  /* A drop-in for boost::variant, as config's variant_t, which is 16
+   * bytes regardless of what it holds: a tag, and either the value
+   * itself or a pointer to it. Numbers, bools and null are held
+   * inline; strings, maps and arrays are boxed, so an array of scalars
+   * is packed densely and a type check is a byte compare. The first
+   * type must fit inline; a variant which has been moved from holds
+   * one. Like boost::get, a get of the wrong type throws
+   * boost::bad_get. */
+  template <typename... Ts>
+  class compact_variant
+  {
+    public:
+      using first_t = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+      compact_variant() noexcept
+      { set_first(); }
+      template
+      <
+        typename T,
+        typename U = std::decay_t<T>,
+        typename E = std::enable_if_t<(detail::index_of<U, Ts...>() < sizeof...(Ts))>
+      >
+      compact_variant(T &&t)
+      { construct<U>(std::forward<T>(t)); }
+      compact_variant(compact_variant const &other)
+        : which_{ other.which_ }
+      { copiers()[which_](storage_, other.storage_); }
+      compact_variant(compact_variant &&other) noexcept
+        : which_{ other.which_ }
+      {
+        std::memcpy(storage_, other.storage_, sizeof(storage_));
+        other.set_first();
+      }
+      ~compact_variant()
+      { destroyers()[which_](storage_); }
+
+      compact_variant& operator =(compact_variant const &other)
+      {
+        if(this != &other)
+        { *this = compact_variant{ other }; }
+        return *this;
+      }
+      compact_variant& operator =(compact_variant &&other) noexcept
+      {
+        if(this != &other)
+        {
+          destroyers()[which_](storage_);
+          which_ = other.which_;
+          std::memcpy(storage_, other.storage_, sizeof(storage_));
+          other.set_first();
+        }
+        return *this;
+      }
+      /* Assigns in place when the type doesn't change. */
+      template
+      <
+        typename T,
+        typename U = std::decay_t<T>,
+        typename E = std::enable_if_t<(detail::index_of<U, Ts...>() < sizeof...(Ts))>
+      >
+      compact_variant& operator =(T &&t)
+      {
+        if(which_ == detail::index_of<U, Ts...>())
+        { *ptr<U>(storage_) = std::forward<T>(t); }
+        else
+        { *this = compact_variant{ std::forward<T>(t) }; }
+        return *this;
+      }
+
+      int which() const noexcept
+      { return which_; }
+
+      template <typename T>
+      T* get_if() noexcept
+      { return which_ == detail::index_of<T, Ts...>() ? ptr<T>(storage_) : nullptr; }
+      template <typename T>
+      T const* get_if() const noexcept
+      { return which_ == detail::index_of<T, Ts...>() ? ptr<T>(storage_) : nullptr; }
+
+      template <typename T>
+      T& get()
+      {
+        if(auto * const t = get_if<T>())
+        { return *t; }
+        throw boost::bad_get{};
+      }
+      template <typename T>
+      T const& get() const
+      {
+        if(auto const * const t = get_if<T>())
+        { return *t; }
+        throw boost::bad_get{};
+      }
+
+      friend bool operator ==(compact_variant const &lhs, compact_variant const &rhs)
+      {
+        return lhs.which_ == rhs.which_ &&
+               comparers()[lhs.which_](lhs.storage_, rhs.storage_);
+      }
+      friend bool operator !=(compact_variant const &lhs, compact_variant const &rhs)
+      { return !(lhs == rhs); }
+      friend std::ostream& operator <<(std::ostream &stream, compact_variant const &v)
+      {
+        printers()[v.which_](stream, v.storage_);
+        return stream;
+      }
+
+    private:
+      using storage_t = unsigned char[sizeof(void*)];
+
+      template <typename T>
+      static std::enable_if_t<detail::fits_inline<T>(), T*> ptr(storage_t &s) noexcept
+      { return reinterpret_cast<T*>(s); }
+      template <typename T>
+      static std::enable_if_t<detail::fits_inline<T>(), T const*>
+      ptr(storage_t const &s) noexcept
+      { return reinterpret_cast<T const*>(s); }
+      template <typename T>
+      static std::enable_if_t<!detail::fits_inline<T>(), T*> ptr(storage_t &s) noexcept
+      { return &(*reinterpret_cast<detail::box<T>**>(s))->value; }
+      template <typename T>
+      static std::enable_if_t<!detail::fits_inline<T>(), T const*>
+      ptr(storage_t const &s) noexcept
+      { return &(*reinterpret_cast<detail::box<T>* const*>(s))->value; }
+
+      template <typename T, typename... Args>
+      static std::enable_if_t<detail::fits_inline<T>()>
+      make(storage_t &s, Args &&...args)
+      { new (s) T(std::forward<Args>(args)...); }
+      template <typename T, typename... Args>
+      static std::enable_if_t<!detail::fits_inline<T>()>
+      make(storage_t &s, Args &&...args)
+      {
+        *reinterpret_cast<detail::box<T>**>(s) =
+          detail::box<T>::make(std::forward<Args>(args)...);
+      }
+
+      template <typename T>
+      static std::enable_if_t<detail::fits_inline<T>()> destroy(storage_t &) noexcept
+      { }
+      template <typename T>
+      static std::enable_if_t<!detail::fits_inline<T>()> destroy(storage_t &s) noexcept
+      { detail::box<T>::destroy(*reinterpret_cast<detail::box<T>**>(s)); }
+      template <typename T>
+      static void copy(storage_t &to, storage_t const &from)
+      { make<T>(to, *ptr<T>(from)); }
+      template <typename T>
+      static bool equal(storage_t const &lhs, storage_t const &rhs)
+      { return *ptr<T>(lhs) == *ptr<T>(rhs); }
+      template <typename T>
+      static void print(std::ostream &stream, storage_t const &s)
+      { stream << *ptr<T>(s); }
+
+      /* One entry per type, indexed by which_. */
+      using destroy_t = void (*)(storage_t &);
+      static destroy_t const* destroyers()
+      {
+        static destroy_t const table[]{ &destroy<Ts>... };
+        return table;
+      }
+      using copy_t = void (*)(storage_t &, storage_t const &);
+      static copy_t const* copiers()
+      {
+        static copy_t const table[]{ &copy<Ts>... };
+        return table;
+      }
+      using equal_t = bool (*)(storage_t const &, storage_t const &);
+      static equal_t const* comparers()
+      {
+        static equal_t const table[]{ &equal<Ts>... };
+        return table;
+      }
+      using print_t = void (*)(std::ostream &, storage_t const &);
+      static print_t const* printers()
+      {
+        static print_t const table[]{ &print<Ts>... };
+        return table;
+      }
+
+      template <typename U, typename T>
+      void construct(T &&t)
+      {
+        make<U>(storage_, std::forward<T>(t));
+        which_ = static_cast<unsigned char>(detail::index_of<U, Ts...>());
+      }
+
+      void set_first() noexcept
+      {
+        static_assert(detail::fits_inline<first_t>(), "the first type must fit inline");
+        make<first_t>(storage_);
+        which_ = 0;
+      }
+
+      alignas(void*) storage_t storage_{};
+      unsigned char which_{};
+  };
+}
@@ -0,0 +1,379 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: cursor.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "span.hpp"
+#include "data.hpp"
+#include "file.hpp"
+#include "detail/tokenize.hpp"
+#include "detail/normalize.hpp"
+#include "detail/document.hpp"
+#include "detail/parser_util.hpp"
+#include "detail/number.hpp"
+
+namespace jeayeson
+{
+  /* A read-only view of a value within raw JSON. Nothing is decoded
+   * until it's asked for; lookups hop over the subtrees they don't need
+   * by matching brackets in the structural index. Copies are cheap and
+   * share the same document.
+   *
+   *   json_cursor const doc{ json_data{ body } };
+   *   auto const id(doc["user"]["id"].get<json_int>());
+   */
+  template <typename Value, typename Parser>
+  class cursor
+  {
+    public:
+      using map_t = map<Value, Parser>;
+      using array_t = array<Value, Parser>;
+      using key_t = std::string;
+      using index_t = typename array_t::index_t;
+      using value_type = Value;
+      using parser_t = Parser;
+      using type = typename Value::type;
+
+      cursor(data const &json)
+        : doc_{ std::make_shared<detail::document>(json.data) }
+      { seek_root(); }
+      cursor(std::string const &json)
+        : doc_{ std::make_shared<detail::document>(json) }
+      { seek_root(); }
+      /* The span must outlive the cursor, and its copies. */
+      cursor(span const &json)
+        : doc_{ std::make_shared<detail::document>(json) }
+      { seek_root(); }
+      cursor(file const &f)
+        : doc_{ std::make_shared<detail::document>(f) }
+      { seek_root(); }
+
+      type get_type() const
+      {
+        switch(first())
+        {
+          case map_t::delim_open:
+            return type::map;
+          case array_t::delim_open:
+            return type::array;
+          case '"':
+            return type::string;
+          case 't':
+          case 'f':
+            return type::boolean;
+          case 'n':
+          case '\0':
+            return type::null;
+          default:
+            return parse_number().is_real ? type::real : type::integer;
+        }
+      }
+      bool is(type const t) const
+      { return get_type() == t; }
+
+      /* Decodes this value, and only this value, as a T. */
+      template <typename T = Value>
+      detail::normalize<T> get() const
+      { return as(tag<detail::normalize<T>>{}); }
+      template <typename T = Value>
+      detail::normalize<T> as() const
+      { return get<T>(); }
+
+      template <typename T = Value>
+      detail::normalize<T> get(key_t const &key) const
+      { return (*this)[key].template get<T>(); }
+      template <typename T = Value>
+      detail::normalize<T> get(key_t const &key, T &&fallback) const
+      {
+        std::size_t const found{ find(key) };
+        if(found == npos)
+        { return static_cast<detail::normalize<T>>(fallback); }
+        return cursor{ doc_, found }.template get<T>();
+      }
+
+      cursor operator [](key_t const &key) const
+      {
+        std::size_t const found{ find(key) };
+        if(found == npos)
+        { throw std::runtime_error{ "no such key: " + key }; }
+        return { doc_, found };
+      }
+      cursor operator [](index_t const index) const
+      {
+        std::size_t const found{ at(index) };
+        if(found == npos)
+        {
+          throw std::runtime_error
+          { "index out of range: " + std::to_string(index) };
+        }
+        return { doc_, found };
+      }
+
+      bool has(key_t const &key) const
+      { return find(key) != npos; }
+
+      template <typename T = Value>
+      detail::normalize<T> get_for_path(std::string const &path) const
+      { return walk(path).template get<T>(); }
+      template <typename T = Value>
+      detail::normalize<T> get_for_path
+      (std::string const &path, T &&fallback) const
+      {
+        cursor c{ *this };
+        for(auto const &token : detail::tokenize(path, "."))
+        {
+          std::size_t const found{ c.find(token) };
+          if(found == npos)
+          { return static_cast<detail::normalize<T>>(fallback); }
+          c.i_ = found;
+        }
+        return c.template get<T>();
+      }
+
+      /* The number of elements in a map or array. An array's elements
+       * aren't decoded; a map's keys are, so that a key given more than
+       * once is counted once, as in a map_t. */
+      std::size_t size() const
+      {
+        if(first() == map_t::delim_open)
+        {
+          std::vector<std::string> keys;
+          for_each_key([&](std::size_t const j)
+          {
+            keys.emplace_back();
+            detail::parse_string(text(j) + 1, text(j + 1), keys.back());
+          });
+          std::sort(keys.begin(), keys.end());
+          return std::unique(keys.begin(), keys.end()) - keys.begin();
+        }
+
+        std::size_t n{};
+        if(first() != array_t::delim_open)
+        { return n; }
+        for(std::size_t j{ i_ + 1 }; j < count(); )
+        {
+          char const c{ at_index(j) };
+          if(c == array_t::delim_close)
+          { break; }
+          else if(c == ',')
+          { ++j; }
+          else
+          {
+            j = skip(j);
+            ++n;
+          }
+        }
+        return n;
+      }
+      bool empty() const
+      { return !size(); }
+
+    private:
+      template <typename T>
+      struct tag
+      { };
+
+      static std::size_t constexpr const npos{ static_cast<std::size_t>(-1) };
+
+      cursor
+      (std::shared_ptr<detail::document const> const &doc, std::size_t const i)
+        : doc_{ doc }
+        , i_{ i }
+      { }
+
+      std::size_t count() const
+      { return doc_->count(); }
+      char at_index(std::size_t const j) const
+      { return doc_->at(j); }
+      char first() const
+      { return at_index(i_); }
+      char const* text(std::size_t const j) const
+      { return doc_->text(j); }
+      char const* end() const
+      { return doc_->end(); }
+      std::size_t skip(std::size_t const j) const
+      { return doc_->skip(j); }
+
+      /* The root is the first map or array; a document which is just a
+       * scalar is one, too. */
+      void seek_root()
+      {
+        for(i_ = 0; i_ < count(); ++i_)
+        {
+          char const c{ first() };
+          if(c != ',' && c != ':')
+          { return; }
+        }
+      }
+
+      bool key_equals(std::size_t const j, key_t const &key) const
+      { return doc_->equals(j, key.data(), key.size()); }
+
+      /* The start of the value for key, or npos. As in a map_t, the
+       * last of any duplicates wins, so every key is looked at. */
+      std::size_t find(key_t const &key) const
+      {
+        std::size_t found{ npos };
+        for_each_key([&](std::size_t const j)
+        {
+          if(key_equals(j, key))
+          { found = j + 3; }
+        });
+        return found;
+      }
+
+      /* Calls f with the first structural of each key in a map. */
+      template <typename F>
+      void for_each_key(F &&f) const
+      {
+        if(first() != map_t::delim_open)
+        { return; }
+
+        for(std::size_t j{ i_ + 1 }; j < count(); )
+        {
+          char const c{ at_index(j) };
+          if(c == map_t::delim_close)
+          { break; }
+          else if(c != '"')
+          { ++j; continue; }
+
+          /* The key's quotes, then the colon, then the value. */
+          std::size_t const value{ j + 3 };
+          if(value >= count())
+          { break; }
+          f(j);
+          j = skip(value);
+        }
+      }
+
+      /* The start of the element at index, or npos. */
+      std::size_t at(index_t const index) const
+      {
+        if(first() != array_t::delim_open)
+        { return npos; }
+
+        index_t n{};
+        for(std::size_t j{ i_ + 1 }; j < count(); )
+        {
+          char const c{ at_index(j) };
+          if(c == array_t::delim_close)
+          { break; }
+          else if(c == ',')
+          { ++j; continue; }
+
+          if(n++ == index)
+          { return j; }
+          j = skip(j);
+        }
+        return npos;
+      }
+
+      cursor walk(std::string const &path) const
+      {
+        cursor c{ *this };
+        for(auto const &token : detail::tokenize(path, "."))
+        { c = c[token]; }
+        return c;
+      }
+
+      void require(type const t, char const * const name) const
+      {
+        if(get_type() != t)
+        {
+          throw std::runtime_error
+          {
+            "invalid value type (" +
+            std::to_string(static_cast<int>(get_type())) +
+            "); required " + name
+          };
+        }
+      }
+
+      detail::number parse_number() const
+      {
+        detail::number num;
+        detail::parse_number(text(i_), end(), num);
+        return num;
+      }
+
+      detail::int_t as(tag<detail::int_t>) const
+      {
+        require(type::integer, "integer");
+        return parse_number().integer;
+      }
+      detail::float_t as(tag<detail::float_t>) const
+      {
+        require(type::real, "real");
+        return parse_number().real;
+      }
+      bool as(tag<bool>) const
+      {
+        require(type::boolean, "boolean");
+        return first() == 't';
+      }
+      std::string as(tag<std::string>) const
+      {
+        require(type::string, "string");
+        std::string out;
+        detail::parse_string(text(i_) + 1, text(i_ + 1), out);
+        return out;
+      }
+      map_t as(tag<map_t>) const
+      {
+        require(type::map, "map");
+        return build<map_t>();
+      }
+      array_t as(tag<array_t>) const
+      {
+        require(type::array, "array");
+        return build<array_t>();
+      }
+      Value as(tag<Value>) const
+      {
+        switch(get_type())
+        {
+          case type::null:
+            return {};
+          case type::integer:
+            return as(tag<detail::int_t>{});
+          case type::real:
+            return as(tag<detail::float_t>{});
+          case type::boolean:
+            return as(tag<bool>{});
+          case type::string:
+            return as(tag<std::string>{});
+          case type::map:
+            return as(tag<map_t>{});
+          case type::array:
+          default:
+            return as(tag<array_t>{});
+        }
+      }
+
+      /* Only this subtree is walked. */
+      template <typename Container>
+      Container build() const
+      {
+        Container c;
+        detail::builder<Value, Parser> b{ c };
+        Parser::parse(b, doc_->json.data, doc_->json.size, doc_->index, i_);
+        return c;
+      }
+
+      std::shared_ptr<detail::document const> doc_;
+      std::size_t i_{};
+  };
+}
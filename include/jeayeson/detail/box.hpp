@@ -0,0 +1,63 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/box.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "config.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* A value which compact_variant holds on the heap, allocated from
+     * config's allocator_t. The box keeps its allocator, which takes no
+     * room unless it has state, so a box made in an arena goes back to
+     * that arena wherever it's freed. */
+    template <typename T>
+    class box : allocator<box<T>>
+    {
+      public:
+        using allocator_t = allocator<box<T>>;
+        using traits = std::allocator_traits<allocator_t>;
+
+        template <typename... Args>
+        box(allocator_t const &alloc, Args &&...args)
+          : allocator_t(alloc)
+          , value(std::forward<Args>(args)...)
+        { }
+
+        template <typename... Args>
+        static box* make(Args &&...args)
+        {
+          allocator_t alloc;
+          box * const b{ traits::allocate(alloc, 1) };
+          try
+          { traits::construct(alloc, b, alloc, std::forward<Args>(args)...); }
+          catch(...)
+          {
+            traits::deallocate(alloc, b, 1);
+            throw;
+          }
+          return b;
+        }
+
+        static void destroy(box * const b) noexcept
+        {
+          allocator_t alloc{ static_cast<allocator_t const&>(*b) };
+          traits::destroy(alloc, b);
+          traits::deallocate(alloc, b, 1);
+        }
+
+        T value;
+    };
+  }
+}
@@ -10,7 +10,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <string>
+
+#include <boost/variant.hpp>
 
 /* XXX: This is not the file you're looking for. See config.hpp,
  * not detail/config.hpp. Less important shit happens here. */
@@ -24,3 +29,55 @@ namespace jeayeson
 }
 
 #include "../config.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    template <typename... Ts>
+    struct make_void
+    { using type = void; };
+    template <typename... Ts>
+    using void_t = typename make_void<Ts...>::type;
+
+    /* Optional config members fall back to these defaults, so older
+     * generated config.hpp files keep working. */
+    template <typename Config, typename E = void>
+    struct max_depth_impl
+    { static std::size_t constexpr const value{ 1024 }; };
+    template <typename Config>
+    struct max_depth_impl<Config, void_t<decltype(Config::max_depth)>>
+    { static std::size_t constexpr const value{ Config::max_depth }; };
+
+    std::size_t constexpr max_depth()
+    { return max_depth_impl<config<config_tag>>::value; }
+
+    template <typename Config, typename E = void>
+    struct allocator_impl
+    {
+      template <typename T>
+      using type = std::allocator<T>;
+    };
+    template <typename Config>
+    struct allocator_impl
+    <Config, void_t<typename Config::template allocator_t<char>>>
+    {
+      template <typename T>
+      using type = typename Config::template allocator_t<T>;
+    };
+
+    template <typename T>
+    using allocator = typename allocator_impl<config<config_tag>>::template type<T>;
+
+    template <typename Config, typename E = void>
+    struct key_impl
+    { using type = std::string; };
+    template <typename Config>
+    struct key_impl<Config, void_t<typename Config::key_t>>
+    { using type = typename Config::key_t; };
+
+    using key_t = typename key_impl<config<config_tag>>::type;
+  }
+}
+
+#include "box.hpp"
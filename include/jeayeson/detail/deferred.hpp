@@ -0,0 +1,102 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/deferred.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <memory>
+
+#include "document.hpp"
+#include "parser_util.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* What a deferred value expands to; see value.hpp. */
+    struct expansion;
+
+    /* A map or array which hasn't been parsed yet; just where it starts
+     * within its document, which it keeps alive. It's expanded in place,
+     * at most once, so reading never changes what a value holds. */
+    struct deferred
+    {
+      deferred(std::shared_ptr<document const> const &d, std::size_t const j);
+      deferred(deferred const &other);
+      deferred(deferred &&other) noexcept;
+      deferred& operator =(deferred const &other);
+      deferred& operator =(deferred &&other) noexcept;
+      ~deferred();
+
+      bool is_map() const
+      { return doc->at(i) == '{'; }
+
+      std::shared_ptr<document const> doc;
+      std::size_t i;
+      /* Owned, so a copy's changes aren't seen by the original. */
+      std::unique_ptr<expansion> expanded;
+    };
+
+    inline bool operator ==(deferred const &lhs, deferred const &rhs)
+    { return lhs.doc == rhs.doc && lhs.i == rhs.i; }
+
+    /* Builds one level of the container which opens at structural i.
+     * Scalars are parsed right away; nested maps and arrays are
+     * deferred in turn. */
+    template <typename Container>
+    void expand
+    (
+      Container &c,
+      std::shared_ptr<document const> const &doc, std::size_t const i
+    )
+    {
+      using value_type = typename Container::value_type;
+      using parser_t = typename Container::parser_t;
+
+      frame<value_type, parser_t> f{ c };
+      for(std::size_t j{ i + 1 }; j < doc->count(); )
+      {
+        char const ch{ doc->at(j) };
+        switch(ch)
+        {
+          case '}':
+          case ']':
+            return;
+
+          case ',':
+          case ':':
+          { ++j; } break;
+
+          default:
+          {
+            /* Keys are the strings followed by a colon. */
+            if(ch == '"' && doc->at(j + 2) == ':')
+            {
+              parse_string(doc->text(j) + 1, doc->text(j + 1), f.name);
+              j += 3;
+              break;
+            }
+
+            value_type &slot(f.template push_back_child<value_type>());
+            if(ch == '{' || ch == '[')
+            {
+              slot = value_type{ deferred{ doc, j } };
+              j = doc->skip(j);
+            }
+            else
+            {
+              builder<value_type, parser_t> b{ slot };
+              j = parser_t::parse
+              (b, doc->json.data, doc->json.size, doc->index, j);
+            }
+          } break;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,116 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/document.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+#include "../span.hpp"
+#include "../file.hpp"
+#include "structural.hpp"
+#include "file_buffer.hpp"
+#include "parser_util.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* Raw JSON, along with its structural index, for everything which
+     * reads it on demand rather than all at once. Values are found by
+     * their first structural, and skipped over by matching brackets. */
+    struct document
+    {
+      document(std::string json)
+        : owned{ std::move(json) }
+        , json{ owned.data(), owned.size() }
+      { index_structurals(this->json.data, this->json.size, index); }
+      /* The span must outlive the document. */
+      document(span const &s)
+        : json{ s }
+      { index_structurals(json.data, json.size, index); }
+      document(file const &f)
+        : buffer{ new file_buffer{ f.data } }
+        , json{ buffer->get() }
+      { index_structurals(json.data, json.size, index); }
+      /* json may point into owned. */
+      document(document const &) = delete;
+      document& operator =(document const &) = delete;
+
+      /* Past the last structural is the end of input. */
+      std::size_t count() const
+      { return index.size(); }
+      char at(std::size_t const j) const
+      { return j < count() ? *text(j) : '\0'; }
+      char const* text(std::size_t const j) const
+      { return j < count() ? json.data + index[j] : end(); }
+      char const* end() const
+      { return json.data + json.size; }
+
+      /* Whether the string which starts at j is the given one. Strings
+       * without escapes are compared in place. */
+      bool equals
+      (std::size_t const j, char const * const str, std::size_t const size) const
+      {
+        char const * const begin{ text(j) + 1 };
+        char const * const close{ text(j + 1) };
+        std::size_t const length(close - begin);
+        if(!std::memchr(begin, '\\', length))
+        { return length == size && std::equal(begin, close, str); }
+
+        std::string decoded;
+        parse_string(begin, close, decoded);
+        return decoded.size() == size && std::equal(str, str + size, decoded.begin());
+      }
+
+      /* The structural just past the value which starts at j. */
+      std::size_t skip(std::size_t j) const
+      {
+        switch(at(j))
+        {
+          case '{':
+          case '[':
+          {
+            std::size_t depth{};
+            do
+            {
+              switch(at(j))
+              {
+                case '{':
+                case '[':
+                { ++depth; ++j; } break;
+                case '}':
+                case ']':
+                { --depth; ++j; } break;
+                /* Both quotes are indexed. */
+                case '"':
+                { j += 2; } break;
+                default:
+                { ++j; } break;
+              }
+            }
+            while(depth && j < count());
+            return j;
+          }
+          case '"':
+            return j + 2;
+          default:
+            return j + 1;
+        }
+      }
+
+      std::string owned;
+      std::unique_ptr<file_buffer> buffer;
+      span json;
+      structural_index index;
+    };
+  }
+}
@@ -0,0 +1,144 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/file_buffer.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "../span.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* The whole contents of a file, for the parser to read in place.
+     * Files are memory mapped where possible, so they're neither copied
+     * nor held twice; otherwise, they're read into a buffer. */
+    class file_buffer
+    {
+      public:
+        enum class mode_t{ mapped, buffered };
+
+        explicit file_buffer
+        (std::string const &path, mode_t const mode = mode_t::mapped)
+        {
+          if(mode == mode_t::mapped && map(path))
+          { return; }
+          read(path);
+        }
+        file_buffer(file_buffer const &) = delete;
+        file_buffer& operator =(file_buffer const &) = delete;
+        ~file_buffer()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+          if(mapping_)
+          { munmap(mapping_, size_); }
+#endif
+        }
+
+        span get() const
+        {
+          if(mapping_)
+          { return { static_cast<char const*>(mapping_), size_ }; }
+          return { buffer_.data(), buffer_.size() };
+        }
+        bool is_mapped() const
+        { return mapping_ != nullptr; }
+
+      private:
+        static void fail(std::string const &path)
+        {
+          throw std::runtime_error
+          { "failed to parse non-existent file: " + path };
+        }
+
+        /* False if the file can't be mapped, but might still be read. */
+        bool map(std::string const &path)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+          int const fd{ ::open(path.c_str(), O_RDONLY) };
+          if(fd < 0)
+          { fail(path); }
+
+          struct stat info;
+          if(::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || !info.st_size)
+          {
+            ::close(fd);
+            return false;
+          }
+
+          void * const mapping
+          {
+            ::mmap
+            (
+              nullptr, static_cast<std::size_t>(info.st_size),
+              PROT_READ, MAP_PRIVATE, fd, 0
+            )
+          };
+          /* The mapping outlives the descriptor. */
+          ::close(fd);
+          if(mapping == MAP_FAILED)
+          { return false; }
+
+  #ifdef MADV_SEQUENTIAL
+          ::madvise(mapping, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+  #endif
+          mapping_ = mapping;
+          size_ = static_cast<std::size_t>(info.st_size);
+          return true;
+#else
+          static_cast<void>(path);
+          return false;
+#endif
+        }
+
+        void read(std::string const &path)
+        {
+          std::ifstream infile{ path.c_str(), std::ios_base::binary };
+          if(!infile.is_open())
+          { fail(path); }
+
+          infile.seekg(0, std::ios_base::end);
+          auto const file_size(infile.tellg());
+          infile.seekg(0, std::ios_base::beg);
+
+          /* Streams, like pipes, can't tell us their size up front. */
+          if(file_size > 0)
+          {
+            buffer_.resize(static_cast<std::size_t>(file_size));
+            infile.read(&buffer_[0], file_size);
+            buffer_.resize(static_cast<std::size_t>(infile.gcount()));
+          }
+          else
+          {
+            infile.clear();
+            buffer_.assign
+            (
+              std::istreambuf_iterator<char>{ infile },
+              std::istreambuf_iterator<char>{}
+            );
+          }
+        }
+
+        void *mapping_{};
+        std::size_t size_{};
+        std::string buffer_;
+    };
+  }
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/lookup.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <utility>
+#include <type_traits>
+
+#include "../key_view.hpp"
+#include "../hash.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* Keys which map takes as a key_view: string literals, C strings
+     * and key_views themselves. */
+    template <typename T, typename E = void>
+    struct is_key_view_impl
+    { static bool constexpr value{ false }; };
+    template <typename T>
+    struct is_key_view_impl
+    <
+      T,
+      std::enable_if_t
+      <
+        std::is_same<std::decay_t<T>, key_view>::value ||
+        std::is_same<std::decay_t<T>, char const*>::value ||
+        std::is_same<std::decay_t<T>, char*>::value
+      >
+    >
+    { static bool constexpr value{ true }; };
+    template <typename T>
+    bool constexpr is_key_view()
+    { return is_key_view_impl<T>::value; }
+
+    template <typename T>
+    using if_key_view = std::enable_if_t<is_key_view<T>()>;
+
+    /* Overloads are tried from the highest rank down. */
+    template <int N>
+    struct rank : rank<N - 1>
+    { };
+    template <>
+    struct rank<0>
+    { };
+
+    /* The backend finds it as it is: std::map with std::less<>, or a
+     * hashed map with a transparent hash. */
+    template <typename Map>
+    auto find_key(Map &m, key_view const key, rank<2>)
+      -> decltype(m.find(key))
+    { return m.find(key); }
+
+    /* The key type knows whether any map could have it, like
+     * interned_key. */
+    template <typename Map, typename K = typename Map::key_type>
+    auto find_key(Map &m, key_view const key, rank<1>)
+      -> decltype(K::existing(key), m.find(std::declval<K const&>()))
+    {
+      auto const k(K::existing(key));
+      return k ? m.find(*k) : m.end();
+    }
+
+    /* Otherwise, a key is made; this allocates for long keys. */
+    template <typename Map, typename K = typename Map::key_type>
+    auto find_key(Map &m, key_view const key, rank<0>)
+    { return m.find(K(key.data(), key.size())); }
+
+    template <typename Map>
+    auto find_key(Map &m, key_view const key)
+    { return find_key(m, key, rank<2>{}); }
+
+    /* Whether find_key finds a key_view without making a key; if not,
+     * as with std::less<K>, long keys allocate. */
+    template <typename Map>
+    constexpr auto finds_in_place(rank<2>)
+      -> decltype(std::declval<Map&>().find(std::declval<key_view>()), true)
+    { return true; }
+    template <typename Map, typename K = typename Map::key_type>
+    constexpr auto finds_in_place(rank<1>)
+      -> decltype(K::existing(std::declval<key_view>()), true)
+    { return true; }
+    template <typename Map>
+    constexpr bool finds_in_place(rank<0>)
+    { return false; }
+
+    template <typename Map>
+    constexpr bool finds_in_place()
+    { return finds_in_place<Map>(rank<2>{}); }
+
+    /* The backend uses the hash that's kept, like flat_map and
+     * swiss_map, or compares with it, like std::map with std::less<>. */
+    template <typename Map, typename K>
+    auto find_key(Map &m, hashed_key<K> const &key, rank<1>)
+      -> decltype(m.find(key))
+    { return m.find(key); }
+
+    /* Otherwise, only the key is used. */
+    template <typename Map, typename K>
+    auto find_key(Map &m, hashed_key<K> const &key, rank<0>)
+    { return m.find(key.key()); }
+
+    template <typename Map, typename K>
+    auto find_key(Map &m, hashed_key<K> const &key)
+    { return find_key(m, key, rank<1>{}); }
+  }
+}
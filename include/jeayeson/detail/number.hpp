@@ -0,0 +1,377 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/number.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <limits>
+#include <locale>
+#include <string>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "normalize.hpp"
+#include "pow5.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* A parsed JSON number; integral unless it has a fraction, an
+     * exponent, or doesn't fit in int_t. */
+    struct number
+    {
+      bool is_real{};
+      int_t integer{};
+      float_t real{};
+    };
+
+    namespace num
+    {
+      struct uint128_t
+      {
+        std::uint64_t low;
+        std::uint64_t high;
+      };
+
+      inline uint128_t multiply(std::uint64_t const a, std::uint64_t const b)
+      {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 wide_t;
+        wide_t const r{ static_cast<wide_t>(a) * b };
+        return { static_cast<std::uint64_t>(r), static_cast<std::uint64_t>(r >> 64) };
+#else
+        std::uint64_t const a_lo{ a & 0xFFFFFFFF }, a_hi{ a >> 32 };
+        std::uint64_t const b_lo{ b & 0xFFFFFFFF }, b_hi{ b >> 32 };
+        std::uint64_t const lo_lo{ a_lo * b_lo }, hi_lo{ a_hi * b_lo };
+        std::uint64_t const lo_hi{ a_lo * b_hi }, hi_hi{ a_hi * b_hi };
+        std::uint64_t const cross
+        { (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi };
+        return
+        {
+          (cross << 32) | (lo_lo & 0xFFFFFFFF),
+          (hi_lo >> 32) + (cross >> 32) + hi_hi
+        };
+#endif
+      }
+
+      inline int leading_zeroes(std::uint64_t const bits)
+      {
+#ifdef __GNUC__
+        return __builtin_clzll(bits);
+#else
+        int n{};
+        for(std::uint64_t b{ bits }; !(b & (std::uint64_t{ 1 } << 63)); b <<= 1)
+        { ++n; }
+        return n;
+#endif
+      }
+
+      /* The IEEE layout of each supported floating point type. Any other
+       * float_t (i.e. long double) always takes the exact path. */
+      template <typename T>
+      struct format;
+      template <>
+      struct format<double>
+      {
+        using bits_t = std::uint64_t;
+        static int constexpr const mantissa_bits{ 52 };
+        static int constexpr const minimum_exponent{ -1023 };
+        static int constexpr const infinite_power{ 0x7FF };
+        static int constexpr const min_round_to_even{ -4 };
+        static int constexpr const max_round_to_even{ 23 };
+        static int constexpr const smallest_power{ -342 };
+        static int constexpr const largest_power{ 308 };
+        static int constexpr const max_exact_power{ 22 };
+        static std::uint64_t constexpr const max_exact_mantissa
+        { std::uint64_t{ 2 } << 52 };
+
+        static double exact_power(int const q)
+        {
+          static double constexpr const powers[]
+          {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+          };
+          return powers[q];
+        }
+      };
+      template <>
+      struct format<float>
+      {
+        using bits_t = std::uint32_t;
+        static int constexpr const mantissa_bits{ 23 };
+        static int constexpr const minimum_exponent{ -127 };
+        static int constexpr const infinite_power{ 0xFF };
+        static int constexpr const min_round_to_even{ -17 };
+        static int constexpr const max_round_to_even{ 10 };
+        static int constexpr const smallest_power{ -64 };
+        static int constexpr const largest_power{ 38 };
+        static int constexpr const max_exact_power{ 10 };
+        static std::uint64_t constexpr const max_exact_mantissa
+        { std::uint64_t{ 2 } << 23 };
+
+        static float exact_power(int const q)
+        {
+          static float constexpr const powers[]
+          { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+          return powers[q];
+        }
+      };
+
+      /* A binary mantissa and biased exponent, ready to be packed. */
+      struct adjusted_t
+      {
+        std::uint64_t mantissa;
+        int power2;
+      };
+
+      /* Eisel-Lemire: w * 10^q, correctly rounded, given that w holds
+       * every significant digit. */
+      template <typename T>
+      adjusted_t eisel_lemire(std::int64_t const q, std::uint64_t w)
+      {
+        using fmt = format<T>;
+        if(w == 0 || q < fmt::smallest_power)
+        { return { 0, 0 }; }
+        if(q > fmt::largest_power)
+        { return { 0, fmt::infinite_power }; }
+
+        int const lz{ leading_zeroes(w) };
+        w <<= lz;
+
+        std::size_t const index{ 2 * static_cast<std::size_t>(q - pow5<>::smallest) };
+        uint128_t product{ multiply(w, pow5<>::table[index]) };
+        std::uint64_t const precision_mask
+        { ~std::uint64_t{} >> (fmt::mantissa_bits + 3) };
+        if((product.high & precision_mask) == precision_mask)
+        {
+          uint128_t const second{ multiply(w, pow5<>::table[index + 1]) };
+          product.low += second.high;
+          if(second.high > product.low)
+          { ++product.high; }
+        }
+
+        int const upper_bit{ static_cast<int>(product.high >> 63) };
+        int const shift{ upper_bit + 64 - fmt::mantissa_bits - 3 };
+        adjusted_t answer
+        {
+          product.high >> shift,
+          static_cast<int>
+          (
+            (((152170 + 65536) * q) >> 16) + 63 +
+            upper_bit - lz - fmt::minimum_exponent
+          )
+        };
+
+        /* Subnormal. */
+        if(answer.power2 <= 0)
+        {
+          if(-answer.power2 + 1 >= 64)
+          { return { 0, 0 }; }
+          answer.mantissa >>= -answer.power2 + 1;
+          answer.mantissa += (answer.mantissa & 1);
+          answer.mantissa >>= 1;
+          answer.power2 =
+            (answer.mantissa < (std::uint64_t{ 1 } << fmt::mantissa_bits)) ? 0 : 1;
+          return answer;
+        }
+
+        /* Exactly halfway between two floats; round to even. */
+        if
+        (
+          product.low <= 1 &&
+          q >= fmt::min_round_to_even && q <= fmt::max_round_to_even &&
+          (answer.mantissa & 3) == 1 &&
+          (answer.mantissa << shift) == product.high
+        )
+        { answer.mantissa &= ~std::uint64_t{ 1 }; }
+
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        if(answer.mantissa >= (std::uint64_t{ 2 } << fmt::mantissa_bits))
+        {
+          answer.mantissa = std::uint64_t{ 1 } << fmt::mantissa_bits;
+          ++answer.power2;
+        }
+        answer.mantissa &= ~(std::uint64_t{ 1 } << fmt::mantissa_bits);
+
+        if(answer.power2 >= fmt::infinite_power)
+        { return { 0, fmt::infinite_power }; }
+        return answer;
+      }
+
+      template <typename T>
+      T to_float(adjusted_t const &a, bool const negative)
+      {
+        using bits_t = typename format<T>::bits_t;
+        bits_t const bits
+        {
+          static_cast<bits_t>
+          (
+            a.mantissa |
+            (static_cast<std::uint64_t>(a.power2) << format<T>::mantissa_bits) |
+            (static_cast<std::uint64_t>(negative) << (sizeof(T) * 8 - 1))
+          )
+        };
+        T out;
+        std::memcpy(&out, &bits, sizeof(T));
+        return out;
+      }
+
+      /* Correctly rounded, but slow and allocating; only reached for
+       * numbers with more than 19 significant digits which land too close
+       * to a rounding boundary, or for unusual float_t types. */
+      template <typename T>
+      T exact(char const * const begin, char const * const end)
+      {
+        std::istringstream is{ std::string{ begin, end } };
+        is.imbue(std::locale::classic());
+        T out{};
+        is >> out;
+        return out;
+      }
+
+      template <typename T>
+      std::enable_if_t<std::is_same<T, float>::value || std::is_same<T, double>::value, T>
+      to_float
+      (
+        char const * const begin, char const * const end,
+        std::uint64_t const w, std::int64_t const q,
+        bool const negative, bool const truncated
+      )
+      {
+        using fmt = format<T>;
+        if(!truncated)
+        {
+          /* Clinger: both operands are exact, so one operation rounds
+           * correctly. */
+          if
+          (
+            w <= fmt::max_exact_mantissa &&
+            q >= -fmt::max_exact_power && q <= fmt::max_exact_power
+          )
+          {
+            T value{ static_cast<T>(w) };
+            if(q < 0)
+            { value /= fmt::exact_power(static_cast<int>(-q)); }
+            else
+            { value *= fmt::exact_power(static_cast<int>(q)); }
+            return negative ? -value : value;
+          }
+          return to_float<T>(eisel_lemire<T>(q, w), negative);
+        }
+
+        /* The dropped digits lie somewhere between w and w + 1. */
+        adjusted_t const lower{ eisel_lemire<T>(q, w) };
+        adjusted_t const upper{ eisel_lemire<T>(q, w + 1) };
+        if(lower.mantissa == upper.mantissa && lower.power2 == upper.power2)
+        { return to_float<T>(lower, negative); }
+        return exact<T>(begin, end);
+      }
+
+      template <typename T>
+      std::enable_if_t<!std::is_same<T, float>::value && !std::is_same<T, double>::value, T>
+      to_float
+      (
+        char const * const begin, char const * const end,
+        std::uint64_t const, std::int64_t const,
+        bool const, bool const
+      )
+      { return exact<T>(begin, end); }
+
+      inline bool is_digit(char const c)
+      { return static_cast<unsigned char>(c - '0') < 10; }
+    }
+
+    /* Reads a JSON number in a single pass; returns the position just
+     * after it. No locale, no NUL terminator, and no allocation. */
+    inline char const* parse_number
+    (char const * const begin, char const * const end, number &out)
+    {
+      char const *it{ begin };
+      bool const negative{ it != end && *it == '-' };
+      if(negative)
+      { ++it; }
+
+      /* Up to 19 significant digits always fit in 64 bits; the rest are
+       * only counted, so they can scale the exponent. */
+      std::uint64_t w{};
+      int significant{};
+      std::int64_t q{};
+      bool truncated{};
+      auto const digit([&](char const c, bool const fraction)
+      {
+        if(significant < 19)
+        {
+          w = w * 10 + static_cast<std::uint64_t>(c - '0');
+          significant += (w != 0);
+          q -= fraction;
+        }
+        else
+        {
+          truncated |= (c != '0');
+          q += !fraction;
+        }
+      });
+
+      for( ; it != end && num::is_digit(*it); ++it)
+      { digit(*it, false); }
+
+      bool is_real{};
+      if(it != end && *it == '.')
+      {
+        is_real = true;
+        for(++it; it != end && num::is_digit(*it); ++it)
+        { digit(*it, true); }
+      }
+
+      if(it != end && (*it == 'e' || *it == 'E'))
+      {
+        is_real = true;
+        ++it;
+        bool const negative_exp{ it != end && *it == '-' };
+        if(it != end && (*it == '-' || *it == '+'))
+        { ++it; }
+
+        std::int64_t exp{};
+        for( ; it != end && num::is_digit(*it); ++it)
+        {
+          /* Anything this large is already zero or infinity. */
+          if(exp < 0x10000)
+          { exp = exp * 10 + (*it - '0'); }
+        }
+        q += negative_exp ? -exp : exp;
+      }
+
+      if(!is_real && !truncated && q == 0)
+      {
+        using limits = std::numeric_limits<int_t>;
+        std::uint64_t const max
+        {
+          static_cast<std::uint64_t>(limits::max()) +
+          (negative && limits::min() < -limits::max())
+        };
+        if(w <= max)
+        {
+          out.is_real = false;
+          out.integer = negative ?
+                        static_cast<int_t>(0 - w) :
+                        static_cast<int_t>(w);
+          return it;
+        }
+      }
+
+      out.is_real = true;
+      out.real = num::to_float<float_t>(begin, it, w, q, negative, truncated);
+      return it;
+    }
+  }
+}
@@ -11,11 +11,21 @@
 
 #include <string>
 #include <sstream>
-#include <fstream>
-#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 
 #include "parser_util.hpp"
+#include "structural.hpp"
+#include "number.hpp"
 #include "escape.hpp"
+#include "file_buffer.hpp"
+#include "thread_pool.hpp"
+#include "deferred.hpp"
+#include "projection.hpp"
+#include "../lazy.hpp"
+#include "../parallel.hpp"
+#include "../validate.hpp"
 
 namespace jeayeson
 {
@@ -23,109 +33,104 @@ namespace jeayeson
   {
     class parser
     {
-      private:
-        template <typename Container>
-        static str_citer parse(Container &container, str_citer it)
+      public:
+        /* Containers nested deeper than this are rejected. */
+        static std::size_t constexpr const max_depth{ detail::max_depth() };
+
+        /* Walks the structural index, starting at the first structural of
+         * a value (usually a container), and reports everything up to its
+         * end to the handler; returns the structural just past it. Open
+         * containers are only counted, rather than recursed into, so the
+         * depth of the input is bounded only by max_depth. */
+        template <typename Handler>
+        static std::size_t parse
+        (
+          Handler &handler,
+          char const * const json, std::size_t const size,
+          structural_index const &index, std::size_t const i
+        )
         {
-          using json_map = map
-          <
-            typename Container::value_type,
-            typename Container::parser_t
-          >;
-          using json_array = array
-          <
-            typename Container::value_type,
-            typename Container::parser_t
-          >;
-
-          std::string name;
-          std::string value;
+          std::string str;
+          return parse(handler, json, size, index, i, str);
+        }
+        /* Strings are decoded into str, which may be kept between calls. */
+        template <typename Handler>
+        static std::size_t parse
+        (
+          Handler &handler,
+          char const * const json, std::size_t const size,
+          structural_index const &index, std::size_t i,
+          std::string &str
+        )
+        {
+          std::size_t depth{};
 
-          /* Maps start out parsing keys, arrays just want values. */
-          state_t state
+          auto const open([&]
           {
-            container.delim_open == json_map::delim_open ?
-            state_t::parse_name : state_t::parse_value
-          };
+            if(depth >= max_depth)
+            {
+              throw std::runtime_error
+              { "exceeded max parse depth: " + std::to_string(max_depth) };
+            }
+            ++depth;
+          });
+          /* A close with nothing open can't belong to this value. */
+          auto const close([&]
+          {
+            if(!depth)
+            { throw std::runtime_error{ "unexpected close" }; }
+            --depth;
+          });
 
-          while(*it)
+          do
           {
+            char const * const it{ json + index[i] };
             switch(*it)
             {
               /* Start of a new map. */
-              case json_map::delim_open:
+              case '{':
               {
-                ++it;
-
-                state = push_back(container, name, json_map{});
-                it = parse(get_map(container, name, container.size() - 1), it);
+                open();
+                handler.start_map();
+                ++i;
               } break;
 
               /* Start of a new array. */
-              case json_array::delim_open:
+              case '[':
               {
-                ++it;
-
-                state = push_back(container, name, json_array{});
-                it = parse(get_array(container, name, container.size() - 1), it);
+                open();
+                handler.start_array();
+                ++i;
               } break;
 
               /* End of the current node. */
-              case json_map::delim_close:
-              case json_array::delim_close:
-              { return ++it; }
+              case '}':
+              {
+                close();
+                handler.end_map();
+                ++i;
+              } break;
+              case ']':
+              {
+                close();
+                handler.end_array();
+                ++i;
+              } break;
 
-              /* Start of a value or key. */
+              /* Start of a value or key; the closing quote is always
+               * the very next structural. Keys are followed by a colon. */
               case '"':
               {
-                ++it;
+                char const * const close
+                { i + 1 < index.size() ? json + index[i + 1] : json + size };
+                parse_string(it + 1, close, str);
 
-                if(state == state_t::parse_value)
-                {
-                  value.clear();
-                  for( ; *it != '"'; ++it)
-                  {
-                    if(*it == '\\')
-                    {
-                      if(*(it + 1) != 'u')
-                      { value += escaped(*(++it)); }
-                      else
-                      {
-                        std::string converted;
-                        std::tie(it, converted) = utf16_to_8(it);
-                        value += converted;
-                      }
-                    }
-                    else
-                    { value += *it; }
-                  }
-
-                  state = push_back(container, name, value);
-                }
-                else /* Parsing a key/name. */
-                {
-                  name.clear();
-                  for( ; *it != '"'; ++it)
-                  {
-                    if(*it == '\\')
-                    {
-                      if(*(it + 1) != 'u')
-                      { name += escaped(*(++it)); }
-                      else
-                      {
-                        std::string converted;
-                        std::tie(it, converted) = utf16_to_8(it);
-                        name += converted;
-                      }
-                    }
-                    else
-                    { name += *it; }
-                  }
-
-                  state = state_t::parse_value;
-                }
+                if(i + 2 < index.size() && json[index[i + 2]] == ':')
+                { handler.key(str); }
+                else
+                { handler.string(str); }
 
-                ++it;
+                i += 2;
               } break;
 
               /* Start of an int or float. */
@@ -141,26 +146,14 @@ namespace jeayeson
               case '9':
               case '0':
               {
-                /* Determine if the value is integral or floating point. */
-                str_citer is_int{ it };
-                while(*is_int == '-' || (*is_int >= '0' && *is_int <= '9'))
-                { ++is_int; }
-                if(*is_int == '.' || *is_int == 'e' || *is_int == 'E')
-                {
-                  char *end{};
-                  state = push_back(container, name, std::strtof(&*it, &end));
-                  std::advance
-                  (
-                    it,
-                    std::distance(&*it, const_cast<char const*>(end))
-                  );
-                }
+                number num;
+                parse_number(it, json + size, num);
+                if(num.is_real)
+                { handler.real(num.real); }
                 else
-                { state = push_back(container, name, std::atoi(&*it)); }
+                { handler.integer(num.integer); }
 
-                /* Progress to the next element. */
-                while(*it == '-' || *it == '.' || (*it >= '0' && *it <= '9'))
-                { ++it; }
+                ++i;
               } break;
 
               /* Start of null, true, or false. */
@@ -168,88 +161,269 @@ namespace jeayeson
               case 't':
               case 'f':
               {
+                if(json + size - it < 4)
+                { ++i; break; }
+
                 if(std::equal(it, it + 3, "null"))
-                {
-                  state = push_back
-                  (
-                    container, name,
-                    typename Container::value_type{}
-                  );
-                }
+                { handler.null(); }
                 else if(std::equal(it, it + 3, "true"))
-                { state = push_back(container, name, true); }
+                { handler.boolean(true); }
                 else
-                { state = push_back(container, name, false); }
-
-                /* Progress to the next element. */
-                while
-                (
-                  *it != ',' && *it != json_map::delim_close &&
-                  *it != json_array::delim_close
-                )
-                { ++it; }
+                { handler.boolean(false); }
+
+                ++i;
               } break;
 
-              /* Whitespace or unimportant/unknown characters. */
+              /* Separators or unimportant/unknown characters. */
               default:
-              { ++it; } break;
+              { ++i; } break;
             }
           }
-
-          return it;
+          while(depth && i < index.size());
+          return i;
         }
 
-      public:
-        template <typename Container>
-        static Container parse(file const &json_file)
+      private:
+        /* Reports the first container opened with delim to the handler;
+         * false if there isn't one. */
+        template <typename Handler, typename Validator = no_validation>
+        static bool parse_first
+        (
+          span const &json, Handler &handler, char const delim,
+          Validator &&validator = {}
+        )
         {
-          std::string json;
+          structural_index index;
+          index_structurals(json.data, json.size, index, validator);
+
+          for(std::size_t i{}; i < index.size(); ++i)
           {
-            std::ifstream infile{ json_file.data.c_str() };
-            if(!infile.is_open())
+            char const c{ json.data[index[i]] };
+            if(c == delim || (!delim && (c == '{' || c == '[')))
             {
-              throw std::runtime_error
-              { "failed to parse non-existent file: " + json_file.data };
+              parse(handler, json.data, json.size, index, i);
+              return true;
             }
+          }
+          return false;
+        }
 
-            infile.seekg(0, std::ios_base::end);
-            auto const file_size(infile.tellg());
-            infile.seekg(0, std::ios_base::beg);
-
-            json.reserve(file_size);
-            std::getline(infile, json, static_cast<char>(-1)); /* EOF */
+        /* The first structural of each element of the array which opens
+         * at structural i. */
+        static std::vector<std::size_t> find_elements
+        (
+          char const * const json,
+          structural_index const &index, std::size_t const i
+        )
+        {
+          std::vector<std::size_t> elements;
+          std::size_t depth{ 1 };
+          for(std::size_t j{ i + 1 }; j < index.size() && depth; )
+          {
+            switch(json[index[j]])
+            {
+              case '{':
+              case '[':
+              {
+                if(depth == 1)
+                { elements.push_back(j); }
+                if(++depth > max_depth)
+                {
+                  throw std::runtime_error
+                  { "exceeded max parse depth: " + std::to_string(max_depth) };
+                }
+                ++j;
+              } break;
+              case '}':
+              case ']':
+              {
+                --depth;
+                ++j;
+              } break;
+              case ',':
+              case ':':
+              { ++j; } break;
+              /* Both quotes are indexed. */
+              case '"':
+              {
+                if(depth == 1)
+                { elements.push_back(j); }
+                j += 2;
+              } break;
+              default:
+              {
+                if(depth == 1)
+                { elements.push_back(j); }
+                ++j;
+              } break;
+            }
           }
+          return elements;
+        }
 
-          return parse<Container>(json);
+      public:
+        /* Files are parsed straight from a memory mapping, if possible. */
+        template <typename Container>
+        static Container parse(file const &json_file)
+        {
+          file_buffer const buffer{ json_file.data };
+          return parse<Container>(buffer.get());
         }
 
         template <typename Container>
         static Container parse(std::string const &json_string)
+        { return parse<Container>(span{ json_string.data(), json_string.size() }); }
+
+        /* Only the given bytes are read, so the input needn't be copied
+         * nor NUL terminated. */
+        template <typename Container>
+        static Container parse(span const &json_span)
         {
-          str_citer it{ json_string.begin() };
+          Container c;
+          builder
+          <
+            typename Container::value_type,
+            typename Container::parser_t
+          > b{ c };
+          parse_first(json_span, b, Container::delim_open);
+          return c;
+        }
+
+        /* Checks that the input is UTF-8 while finding its structure;
+         * the rest of the parse is the same. */
+        template <typename Container>
+        static Container parse(span const &json_span, validate const &)
+        {
+          Container c;
+          builder
+          <
+            typename Container::value_type,
+            typename Container::parser_t
+          > b{ c };
+          parse_first(json_span, b, Container::delim_open, utf8_validator{});
+          return c;
+        }
+        template <typename Container>
+        static Container parse(data const &json, validate const &v)
+        { return parse<Container>(span{ json.data.data(), json.data.size() }, v); }
+        template <typename Container>
+        static Container parse(file const &json_file, validate const &v)
+        {
+          file_buffer const buffer{ json_file.data };
+          return parse<Container>(buffer.get(), v);
+        }
 
-          while(*it)
+        /* Finds where each element of the first array starts, then
+         * parses the elements across a pool of threads, each straight
+         * into its own slot of the result. */
+        template <typename Array>
+        static Array parse(span const &json_span, parallel const &p)
+        {
+          Array arr;
+          structural_index index;
+          index_structurals(json_span.data, json_span.size, index);
+
+          auto const open
+          (
+            std::find_if(index.begin(), index.end(), [&](std::size_t const offset)
+            { return json_span.data[offset] == Array::delim_open; })
+          );
+          if(open == index.end())
+          { return arr; }
+
+          std::vector<std::size_t> const elements
+          { find_elements(json_span.data, index, open - index.begin()) };
+          arr.resize(elements.size());
+
+          thread_pool pool{ p.threads };
+          std::size_t const tasks{ std::min(elements.size(), pool.size() * 8) };
+          pool.run(tasks, [&](std::size_t const t)
           {
-            switch(*it)
+            std::size_t const end{ elements.size() * (t + 1) / tasks };
+            for(std::size_t e{ elements.size() * t / tasks }; e < end; ++e)
             {
-              case Container::delim_open:
-              {
-                ++it;
-
-                /* Recursively parse the object. */
-                Container c;
-                it = parse(c, it);
-                return c;
-              }
+              builder
+              <
+                typename Array::value_type,
+                typename Array::parser_t
+              > b{ arr[e] };
+              parse(b, json_span.data, json_span.size, index, elements[e]);
+            }
+          });
+          return arr;
+        }
+        template <typename Array>
+        static Array parse(file const &json_file, parallel const &p)
+        {
+          file_buffer const buffer{ json_file.data };
+          return parse<Array>(buffer.get(), p);
+        }
 
-              /* Whitespace. */
-              default:
-              { ++it; } break;
+        /* Builds just the root container; anything nested within it is
+         * kept as raw JSON until it's first touched, so the text is kept
+         * alive for as long as any of that is. */
+        template <typename Container>
+        static Container parse(data const &json, lazy const &l)
+        { return parse<Container>(std::make_shared<document const>(json.data), l); }
+        /* The span is copied, since it needn't outlive the parse. */
+        template <typename Container>
+        static Container parse(span const &json, lazy const &l)
+        {
+          return parse<Container>
+          (std::make_shared<document const>(std::string{ json.data, json.size }), l);
+        }
+        template <typename Container>
+        static Container parse(file const &json_file, lazy const &l)
+        { return parse<Container>(std::make_shared<document const>(json_file), l); }
+        template <typename Container>
+        static Container parse
+        (std::shared_ptr<document const> const &doc, lazy const &)
+        {
+          Container c;
+          for(std::size_t i{}; i < doc->count(); ++i)
+          {
+            if(doc->at(i) == Container::delim_open)
+            {
+              expand(c, doc, i);
+              break;
             }
           }
+          return c;
+        }
 
-          return Container{};
+        /* Builds only the paths in the projection, and their ancestors,
+         * of the first map; see detail/projection.hpp. */
+        template <typename Map>
+        static Map parse(span const &json_span, projection const &p)
+        {
+          Map m;
+          document const doc{ json_span };
+          path_tree const tree{ p };
+          for(std::size_t i{}; i < doc.count(); ++i)
+          {
+            if(doc.at(i) == Map::delim_open)
+            {
+              project(m, doc, i, tree);
+              break;
+            }
+          }
+          return m;
         }
+        template <typename Map>
+        static Map parse(data const &json, projection const &p)
+        { return parse<Map>(span{ json.data.data(), json.data.size() }, p); }
+        template <typename Map>
+        static Map parse(file const &json_file, projection const &p)
+        {
+          file_buffer const buffer{ json_file.data };
+          return parse<Map>(buffer.get(), p);
+        }
+
+        /* Reports the first map or array in the input to the handler,
+         * without building anything; see handler.hpp. */
+        template <typename Handler>
+        static bool parse(span const &json_span, Handler &handler)
+        { return parse_first(json_span, handler, '\0'); }
 
         template <typename Container>
         static std::string save(Container const &container)
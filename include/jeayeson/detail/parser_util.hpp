@@ -10,14 +10,20 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <sstream>
 #include <iterator>
 #include <algorithm>
+#include <cassert>
 
 #include "../map.hpp"
 #include "../array.hpp"
 #include "../file.hpp"
+#include "../span.hpp"
 #include "utf.hpp"
+#include "simd.hpp"
+#include "escape.hpp"
+#include "normalize.hpp"
 
 namespace jeayeson
 {
@@ -25,15 +31,63 @@ namespace jeayeson
   {
     enum class state_t{ parse_name, parse_value };
 
+    /* Whether a value can begin with c; a stray close or separator
+     * can't, so the parser mustn't be started there. */
+    inline bool starts_value(char const c)
+    {
+      switch(c)
+      {
+        case '{':
+        case '[':
+        case '"':
+        case '-':
+        case 't':
+        case 'f':
+        case 'n':
+          return true;
+        default:
+          return c >= '0' && c <= '9';
+      }
+    }
+
+    /* Decodes the characters between two quotes. Runs without escapes
+     * are found with SIMD and appended whole. */
+    inline void parse_string
+    (char const *it, char const * const end, std::string &out)
+    {
+      out.clear();
+      while(it != end)
+      {
+        char const * const run{ simd::find_quote_or_escape(it, end) };
+        out.append(it, run);
+        if(run == end)
+        { break; }
+
+        it = run;
+        if(*it == '\\')
+        {
+          if(end - it < 2)
+          { break; }
+          else if(*(it + 1) != 'u' || end - it < 6)
+          { out += escaped(*(++it)); }
+          else
+          { it = utf16_to_8(it, end, out); }
+        }
+        else
+        { out += *it; }
+        ++it;
+      }
+    }
+
     template <typename Value, typename Parser, typename T>
     state_t push_back
     (
       map<Value, Parser> &m,
       std::string const &key,
-      T const &t
+      T &&t
     )
     {
-      m.set(key, t);
+      m.set(key, std::forward<T>(t));
       return state_t::parse_name;
     }
 
@@ -42,47 +96,239 @@ namespace jeayeson
     (
       array<Value, Parser> &arr,
       std::string const &,
-      T const &t
+      T &&t
     )
     {
-      arr.push_back(t);
+      arr.push_back(std::forward<T>(t));
       return state_t::parse_value;
     }
 
-    template <typename Value, typename Parser>
-    map<Value, Parser>& get_map
-    (
-      map<Value, Parser> &m,
-      std::string const &key,
-      typename array<Value, Parser>::index_t const
-    )
-    { return m.template get<map<Value, Parser>>(key); }
+    /* A lone value, of any type, is a slot which holds just one. */
+    template <typename Value, typename T>
+    state_t push_back(Value &slot, std::string const &, T &&t)
+    {
+      slot = std::forward<T>(t);
+      return state_t::parse_value;
+    }
 
-    template <typename Value, typename Parser>
-    map<Value, Parser>& get_map
-    (
-      array<Value, Parser> &arr,
-      std::string const &,
-      typename array<Value, Parser>::index_t const index
-    )
-    { return arr.template get<map<Value, Parser>>(index); }
+    /* Adds an empty container and hands it back, so the parser can fill
+     * it without looking it up again. */
+    template <typename T, typename Value, typename Parser>
+    T& push_back_child(map<Value, Parser> &m, std::string const &key)
+    {
+      Value &val(m[key]);
+      val = T{};
+      return val.template as<T>();
+    }
+
+    template <typename T, typename Value, typename Parser>
+    T& push_back_child(array<Value, Parser> &arr, std::string const &)
+    {
+      arr.push_back(T{});
+      return arr[arr.size() - 1].template as<T>();
+    }
 
+    template <typename T, typename Value>
+    T& push_back_child(Value &slot, std::string const &)
+    {
+      slot = T{};
+      return slot.template as<T>();
+    }
+
+    /* An open container on the parser's explicit stack, along with
+     * whatever key it's waiting to use. */
     template <typename Value, typename Parser>
-    array<Value, Parser>& get_array
-    (
-      map<Value, Parser> &m,
-      std::string const &key,
-      typename array<Value, Parser>::index_t const
-    )
-    { return m.template get<array<Value, Parser>>(key); }
+    struct frame
+    {
+      frame(map<Value, Parser> &m)
+        : map_{ &m }
+        , state{ state_t::parse_name }
+      { }
+      frame(array<Value, Parser> &arr)
+        : array_{ &arr }
+        , state{ state_t::parse_value }
+      { }
+      frame(Value &slot)
+        : slot_{ &slot }
+        , state{ state_t::parse_value }
+      { }
+
+      /* Points at another container, keeping the storage of the name
+       * and of the gathered elements. */
+      void retarget(frame const &f)
+      {
+        map_ = f.map_;
+        array_ = f.array_;
+        slot_ = f.slot_;
+        state = f.state;
+        gather = f.gather;
+        items.clear();
+      }
 
+      /* Moves gathered elements into the array, sized just once. */
+      void flush()
+      {
+        if(!gather || !array_)
+        { return; }
+        array_->reserve(array_->size() + items.size());
+        for(auto &item : items)
+        { array_->push_back(std::move(item)); }
+        items.clear();
+      }
+
+      template <typename T>
+      void push_back(T &&t)
+      {
+        if(gather && array_)
+        {
+          items.emplace_back(std::forward<T>(t));
+          return;
+        }
+        state = map_ ? detail::push_back(*map_, name, std::forward<T>(t)) :
+                array_ ? detail::push_back(*array_, name, std::forward<T>(t)) :
+                detail::push_back(*slot_, name, std::forward<T>(t));
+      }
+
+      template <typename T>
+      T& push_back_child()
+      {
+        state = map_ ? state_t::parse_name : state_t::parse_value;
+        if(gather && array_)
+        {
+          items.emplace_back(T{});
+          return items.back().template as<T>();
+        }
+        return map_ ? detail::push_back_child<T>(*map_, name) :
+               array_ ? detail::push_back_child<T>(*array_, name) :
+               detail::push_back_child<T>(*slot_, name);
+      }
+
+      map<Value, Parser> *map_{};
+      array<Value, Parser> *array_{};
+      Value *slot_{};
+      std::string name;
+      state_t state;
+      /* An array's elements are gathered here, then moved in when it
+       * closes, rather than growing the array one at a time. */
+      bool gather{};
+      std::vector<Value> items;
+    };
+
+    /* Builds containers out of the parser's events; the default
+     * handler. Strings are swapped in, rather than copied. The stack
+     * may be borrowed, so that its frames, and the storage of their
+     * names, outlive the builder and can be reused. Then keys and
+     * strings are copied, so the parser's string buffer keeps its
+     * storage too, and arrays are gathered, so they're sized once. */
     template <typename Value, typename Parser>
-    array<Value, Parser>& get_array
-    (
-      array<Value, Parser> &arr,
-      std::string const &,
-      typename array<Value, Parser>::index_t const index
-    )
-    { return arr.template get<array<Value, Parser>>(index); }
+    class builder
+    {
+      public:
+        using value_type = Value;
+        using parser_t = Parser;
+        using map_t = map<value_type, parser_t>;
+        using array_t = array<value_type, parser_t>;
+        using frame_t = frame<value_type, parser_t>;
+
+        builder(map_t &root)
+          : builder{ root, own_ }
+        { }
+        builder(array_t &root)
+          : builder{ root, own_ }
+        { }
+        /* A value of any type, including a lone scalar. */
+        builder(value_type &root)
+          : builder{ root, own_ }
+        { }
+
+        builder(map_t &root, std::vector<frame_t> &stack)
+          : root_{ root }
+          , stack_(stack)
+        { }
+        builder(array_t &root, std::vector<frame_t> &stack)
+          : root_{ root }
+          , stack_(stack)
+        { }
+        builder(value_type &root, std::vector<frame_t> &stack)
+          : root_{ root }
+          , stack_(stack)
+        { push(root_); }
+        /* stack_ may refer to own_. */
+        builder(builder const &) = delete;
+        builder& operator =(builder const &) = delete;
+
+        void start_map()
+        { start<map_t>(); }
+        void end_map()
+        { assert(size_ > 0); --size_; }
+        void start_array()
+        { start<array_t>(); }
+        void end_array()
+        { assert(size_ > 0); top().flush(); --size_; }
+
+        void key(std::string &k)
+        {
+          if(borrowed())
+          { top().name = k; }
+          else
+          { top().name.swap(k); }
+        }
+        void string(std::string &s)
+        {
+          std::string &out(top().template push_back_child<std::string>());
+          if(borrowed())
+          { out = s; }
+          else
+          { out.swap(s); }
+        }
+        void integer(int_t const i)
+        { top().push_back(i); }
+        void real(float_t const f)
+        { top().push_back(f); }
+        void boolean(bool const b)
+        { top().push_back(b); }
+        void null()
+        { top().push_back(value_type{}); }
+
+        /* Fills any arrays left open by input which ended early. */
+        void finish()
+        {
+          for(std::size_t i{ size_ }; i > 0; --i)
+          { stack_[i - 1].flush(); }
+        }
+
+      private:
+        frame_t& top()
+        { return stack_[size_ - 1]; }
+
+        bool borrowed() const
+        { return &stack_ != &own_; }
+
+        void push(frame_t f)
+        {
+          f.gather = borrowed();
+          if(size_ == stack_.size())
+          { stack_.push_back(std::move(f)); }
+          else
+          { stack_[size_].retarget(f); }
+          ++size_;
+        }
+
+        /* Unless the root is a slot, the first container opened is the
+         * root itself. */
+        template <typename T>
+        void start()
+        {
+          if(!size_)
+          { push(root_); }
+          else
+          { push(frame_t{ top().template push_back_child<T>() }); }
+        }
+
+        std::vector<frame_t> own_;
+        frame_t root_;
+        std::vector<frame_t> &stack_;
+        std::size_t size_{};
+    };
   }
 }
@@ -0,0 +1,129 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/projection.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../projection.hpp"
+#include "document.hpp"
+#include "parser_util.hpp"
+#include "tokenize.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* The paths of a projection, merged by their common prefixes. A
+     * node which ends a path is kept whole, whatever else is below it. */
+    struct path_tree
+    {
+      path_tree() = default;
+      explicit path_tree(projection const &p)
+      {
+        for(auto const &path : p.paths)
+        { add(tokenize(path, ".")); }
+      }
+
+      void add(std::vector<std::string> const &tokens)
+      {
+        path_tree *node{ this };
+        for(auto const &token : tokens)
+        {
+          auto const it
+          (
+            std::find_if
+            (
+              node->children.begin(), node->children.end(),
+              [&](path_tree const &child){ return child.name == token; }
+            )
+          );
+          if(it != node->children.end())
+          { node = &*it; }
+          else
+          {
+            node->children.emplace_back();
+            node = &node->children.back();
+            node->name = token;
+          }
+        }
+        node->whole = true;
+      }
+
+      std::string name;
+      std::vector<path_tree> children;
+      bool whole{};
+    };
+
+    /* Fills the map which opens at structural j with just the paths in
+     * the tree. Keys are compared in place, and anything which isn't on
+     * a path is skipped by matching brackets, without being decoded. */
+    template <typename Value, typename Parser>
+    void project
+    (
+      map<Value, Parser> &m, document const &doc,
+      std::size_t j, path_tree const &tree
+    )
+    {
+      using map_t = map<Value, Parser>;
+
+      std::string name;
+      for(++j; j < doc.count(); )
+      {
+        char const c{ doc.at(j) };
+        if(c == map_t::delim_close)
+        { return; }
+        else if(c != '"')
+        { ++j; continue; }
+
+        /* The key's quotes, then the colon, then the value. */
+        std::size_t const key{ j };
+        j += 3;
+        if(!starts_value(doc.at(j)))
+        { throw std::runtime_error{ "invalid value in map" }; }
+        auto const child
+        (
+          std::find_if
+          (
+            tree.children.begin(), tree.children.end(),
+            [&](path_tree const &t)
+            { return doc.equals(key, t.name.data(), t.name.size()); }
+          )
+        );
+        if(child == tree.children.end())
+        {
+          j = doc.skip(j);
+          continue;
+        }
+
+        name.clear();
+        parse_string(doc.text(key) + 1, doc.text(key + 1), name);
+        if(child->whole)
+        {
+          builder<Value, Parser> b{ m[name] };
+          j = Parser::parse(b, doc.json.data, doc.json.size, doc.index, j);
+        }
+        else
+        {
+          /* Paths only lead through maps. */
+          if(doc.at(j) == map_t::delim_open)
+          {
+            Value &slot(m[name]);
+            slot = map_t{};
+            project(slot.template as<map_t>(), doc, j, *child);
+          }
+          j = doc.skip(j);
+        }
+      }
+    }
+  }
+}
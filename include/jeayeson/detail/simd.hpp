@@ -0,0 +1,269 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/simd.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #include <immintrin.h>
+#endif
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    namespace simd
+    {
+      /* The widest instruction set we're allowed to use; picked once, at
+       * runtime, so the same binary runs on older hardware. */
+      enum class isa_t{ scalar, sse2, avx2 };
+
+      inline isa_t detect_isa()
+      {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+        { return isa_t::avx2; }
+        if(__builtin_cpu_supports("sse2"))
+        { return isa_t::sse2; }
+#endif
+        return isa_t::scalar;
+      }
+
+      inline isa_t isa()
+      {
+        static isa_t const detected{ detect_isa() };
+        return detected;
+      }
+
+      /* Every 64 byte block of input is boiled down to these bitmasks;
+       * bit N corresponds to byte N of the block. */
+      struct block_t
+      {
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t op; /* { } [ ] : , */
+        std::uint64_t whitespace;
+      };
+      std::size_t constexpr const block_size{ 64 };
+
+      inline int trailing_zeroes(std::uint64_t const bits)
+      {
+#ifdef __GNUC__
+        return __builtin_ctzll(bits);
+#else
+        int n{};
+        for(std::uint64_t b{ bits }; !(b & 1); b >>= 1)
+        { ++n; }
+        return n;
+#endif
+      }
+
+      inline void classify_scalar
+      (char const *in, std::size_t const blocks, block_t *out)
+      {
+        for(std::size_t b{}; b < blocks; ++b, in += block_size)
+        {
+          block_t block{};
+          for(std::size_t i{}; i < block_size; ++i)
+          {
+            std::uint64_t const bit{ std::uint64_t{ 1 } << i };
+            switch(in[i])
+            {
+              case '"':
+                block.quote |= bit; break;
+              case '\\':
+                block.backslash |= bit; break;
+              case '{': case '}': case '[': case ']': case ':': case ',':
+                block.op |= bit; break;
+              case ' ': case '\t': case '\n': case '\r':
+                block.whitespace |= bit; break;
+              default:
+                break;
+            }
+          }
+          out[b] = block;
+        }
+      }
+
+      inline char const* find_quote_or_escape_scalar
+      (char const *it, char const * const end)
+      {
+        for( ; it != end && *it != '"' && *it != '\\'; ++it)
+        { }
+        return it;
+      }
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+      /* Bitmask of the bytes in v which equal c. */
+      __attribute__((target("sse2")))
+      inline std::uint64_t eq_sse2(__m128i const v, char const c)
+      {
+        return std::uint16_t
+        (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c))));
+      }
+
+      __attribute__((target("sse2")))
+      inline void classify_sse2
+      (char const *in, std::size_t const blocks, block_t *out)
+      {
+        for(std::size_t b{}; b < blocks; ++b, in += block_size)
+        {
+          block_t block{};
+          for(std::size_t i{}; i < block_size; i += 16)
+          {
+            __m128i const v
+            { _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+
+            block.quote |= eq_sse2(v, '"') << i;
+            block.backslash |= eq_sse2(v, '\\') << i;
+            block.op |=
+            (
+              eq_sse2(v, '{') | eq_sse2(v, '}') |
+              eq_sse2(v, '[') | eq_sse2(v, ']') |
+              eq_sse2(v, ':') | eq_sse2(v, ',')
+            ) << i;
+            block.whitespace |=
+            (
+              eq_sse2(v, ' ') | eq_sse2(v, '\t') |
+              eq_sse2(v, '\n') | eq_sse2(v, '\r')
+            ) << i;
+          }
+          out[b] = block;
+        }
+      }
+
+      __attribute__((target("avx2")))
+      inline std::uint64_t eq_avx2(__m256i const v, char const c)
+      {
+        return std::uint32_t
+        (_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))));
+      }
+
+      __attribute__((target("avx2")))
+      inline void classify_avx2
+      (char const *in, std::size_t const blocks, block_t *out)
+      {
+        for(std::size_t b{}; b < blocks; ++b, in += block_size)
+        {
+          block_t block{};
+          for(std::size_t i{}; i < block_size; i += 32)
+          {
+            __m256i const v
+            { _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i)) };
+
+            block.quote |= eq_avx2(v, '"') << i;
+            block.backslash |= eq_avx2(v, '\\') << i;
+            block.op |=
+            (
+              eq_avx2(v, '{') | eq_avx2(v, '}') |
+              eq_avx2(v, '[') | eq_avx2(v, ']') |
+              eq_avx2(v, ':') | eq_avx2(v, ',')
+            ) << i;
+            block.whitespace |=
+            (
+              eq_avx2(v, ' ') | eq_avx2(v, '\t') |
+              eq_avx2(v, '\n') | eq_avx2(v, '\r')
+            ) << i;
+          }
+          out[b] = block;
+        }
+      }
+
+      __attribute__((target("sse2")))
+      inline char const* find_quote_or_escape_sse2
+      (char const *it, char const * const end)
+      {
+        __m128i const quote{ _mm_set1_epi8('"') };
+        __m128i const backslash{ _mm_set1_epi8('\\') };
+        for( ; end - it >= 16; it += 16)
+        {
+          __m128i const v
+          { _mm_loadu_si128(reinterpret_cast<__m128i const*>(it)) };
+          int const mask
+          {
+            _mm_movemask_epi8
+            (_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)))
+          };
+          if(mask)
+          { return it + trailing_zeroes(static_cast<std::uint64_t>(mask)); }
+        }
+        return find_quote_or_escape_scalar(it, end);
+      }
+
+      __attribute__((target("avx2")))
+      inline char const* find_quote_or_escape_avx2
+      (char const *it, char const * const end)
+      {
+        __m256i const quote{ _mm256_set1_epi8('"') };
+        __m256i const backslash{ _mm256_set1_epi8('\\') };
+        for( ; end - it >= 32; it += 32)
+        {
+          __m256i const v
+          { _mm256_loadu_si256(reinterpret_cast<__m256i const*>(it)) };
+          std::uint32_t const mask
+          {
+            static_cast<std::uint32_t>
+            (
+              _mm256_movemask_epi8
+              (
+                _mm256_or_si256
+                (_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash))
+              )
+            )
+          };
+          if(mask)
+          { return it + trailing_zeroes(mask); }
+        }
+        return find_quote_or_escape_sse2(it, end);
+      }
+#endif
+
+      /* Classifies whole blocks with the best available instruction set.
+       * The call is made per batch of blocks, not per block, so the
+       * dispatch cost disappears. */
+      inline void classify
+      (char const * const in, std::size_t const blocks, block_t * const out)
+      {
+        switch(isa())
+        {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+          case isa_t::avx2:
+            return classify_avx2(in, blocks, out);
+          case isa_t::sse2:
+            return classify_sse2(in, blocks, out);
+#endif
+          default:
+            return classify_scalar(in, blocks, out);
+        }
+      }
+
+      /* The first quote or backslash in [it, end), or end; strings are
+       * copied in runs between these. */
+      inline char const* find_quote_or_escape
+      (char const * const it, char const * const end)
+      {
+        switch(isa())
+        {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+          case isa_t::avx2:
+            return find_quote_or_escape_avx2(it, end);
+          case isa_t::sse2:
+            return find_quote_or_escape_sse2(it, end);
+#endif
+          default:
+            return find_quote_or_escape_scalar(it, end);
+        }
+      }
+    }
+  }
+}
@@ -11,19 +11,6 @@
 
 namespace jeayeson
 {
-  inline std::ostream& operator <<(std::ostream &stream, value const &val)
-  {
-    switch(static_cast<value::type>(val.value_.which()))
-    {
-      case value::type::string:
-        return (stream << "\"" << detail::escape(val.as<std::string>()) << "\"");
-      case value::type::boolean:
-        return (stream << (val.as<bool>() ? "true" : "false"));
-      default:
-        return (stream << val.value_);
-    }
-  }
-
   template <typename Iter>
   inline void streamjoin
   (
@@ -76,4 +63,26 @@ namespace jeayeson
     stream << m.delim_close;
     return stream;
   }
+
+  inline std::ostream& operator <<(std::ostream &stream, value const &val)
+  {
+    switch(val.get_type())
+    {
+      case value::type::null:
+        return (stream << "null");
+      case value::type::integer:
+        return (stream << val.as<detail::int_t>());
+      case value::type::real:
+        return (stream << val.as<detail::float_t>());
+      case value::type::boolean:
+        return (stream << (val.as<bool>() ? "true" : "false"));
+      case value::type::string:
+        return (stream << "\"" << detail::escape(val.as<std::string>()) << "\"");
+      case value::type::map:
+        return (stream << val.as<value::map_t>());
+      case value::type::array:
+      default:
+        return (stream << val.as<value::array_t>());
+    }
+  }
 }
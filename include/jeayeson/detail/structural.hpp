@@ -0,0 +1,183 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/structural.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "simd.hpp"
+#include "utf8.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* Stage one of parsing: a single pass over the input which records the
+     * position of every structural character ({ } [ ] : ,) outside of a
+     * string, both quotes of every string, and the first byte of every
+     * number or literal. The builder then hops from index to index
+     * instead of looking at each byte. */
+    using structural_index = std::vector<std::size_t>;
+
+    namespace structural
+    {
+      /* Blocks are classified in batches to amortize the SIMD dispatch. */
+      std::size_t constexpr const batch_blocks{ 64 };
+
+      /* Carries state from one 64 byte block to the next. */
+      struct state_t
+      {
+        std::uint64_t escape_next{};
+        std::uint64_t in_string{};
+        std::uint64_t scalar{};
+      };
+
+      inline bool add_overflow
+      (std::uint64_t const a, std::uint64_t const b, std::uint64_t &out)
+      {
+        out = a + b;
+        return out < a;
+      }
+
+      /* Turns each set bit into a mask of ones up to the next set bit;
+       * the carry-less multiplication of bits by all ones. */
+      inline std::uint64_t prefix_xor(std::uint64_t bits)
+      {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+      }
+
+      /* The characters which are escaped by a backslash; a run of
+       * backslashes only escapes the following character if it has
+       * an odd length. */
+      inline std::uint64_t escaped_bits
+      (std::uint64_t backslash, state_t &state)
+      {
+        if(!backslash)
+        {
+          std::uint64_t const next{ state.escape_next };
+          state.escape_next = 0;
+          return next;
+        }
+
+        std::uint64_t const even_bits{ 0x5555555555555555ULL };
+        backslash &= ~state.escape_next;
+        std::uint64_t const follows_escape
+        { (backslash << 1) | state.escape_next };
+        std::uint64_t const odd_starts
+        { backslash & ~even_bits & ~follows_escape };
+        std::uint64_t even_sequences{};
+        state.escape_next = add_overflow(odd_starts, backslash, even_sequences);
+        return (even_bits ^ (even_sequences << 1)) & follows_escape;
+      }
+
+      inline std::uint64_t structurals
+      (simd::block_t const &block, state_t &state)
+      {
+        std::uint64_t const quote
+        { block.quote & ~escaped_bits(block.backslash, state) };
+
+        /* Everything from an opening quote up to, but not including, the
+         * closing quote. */
+        std::uint64_t const in_string{ prefix_xor(quote) ^ state.in_string };
+        state.in_string = std::uint64_t
+        (static_cast<std::int64_t>(in_string) >> 63);
+
+        /* Numbers and literals only need their first byte recorded. */
+        std::uint64_t const scalar
+        { ~(block.op | block.whitespace | block.quote) & ~in_string };
+        std::uint64_t const scalar_start
+        { scalar & ~((scalar << 1) | state.scalar) };
+        state.scalar = scalar >> 63;
+
+        return (block.op & ~in_string) | quote | scalar_start;
+      }
+
+      inline void flatten
+      (
+        std::uint64_t bits, std::size_t const base,
+        std::size_t * const out, std::size_t &count
+      )
+      {
+        while(bits)
+        {
+          out[count++] = base + simd::trailing_zeroes(bits);
+          bits &= bits - 1;
+        }
+      }
+    }
+
+    /* The validator sees each batch of blocks right after they're
+     * classified, while they're still in cache. */
+    template <typename Validator>
+    void index_structurals
+    (
+      char const * const json, std::size_t const size,
+      structural_index &out, Validator &validator
+    )
+    {
+      out.resize(std::max<std::size_t>(out.size(), simd::block_size));
+      std::size_t count{};
+      structural::state_t state;
+      simd::block_t blocks[structural::batch_blocks];
+
+      auto const process([&](simd::block_t const &block, std::size_t const base)
+      {
+        if(out.size() - count < simd::block_size)
+        { out.resize(out.size() * 2); }
+        structural::flatten
+        (structural::structurals(block, state), base, out.data(), count);
+      });
+
+      std::size_t const whole_blocks{ size / simd::block_size };
+      for(std::size_t b{}; b < whole_blocks; b += structural::batch_blocks)
+      {
+        std::size_t const batch
+        { std::min(structural::batch_blocks, whole_blocks - b) };
+        simd::classify(json + b * simd::block_size, batch, blocks);
+        validator.blocks(json + b * simd::block_size, batch);
+        for(std::size_t i{}; i < batch; ++i)
+        { process(blocks[i], (b + i) * simd::block_size); }
+      }
+
+      /* The trailing partial block is padded with whitespace. */
+      std::size_t const tail{ size % simd::block_size };
+      if(tail)
+      {
+        char padded[simd::block_size];
+        std::memset(padded, ' ', simd::block_size);
+        std::memcpy(padded, json + size - tail, tail);
+        simd::classify(padded, 1, blocks);
+        validator.blocks(padded, 1);
+        process(blocks[0], size - tail);
+      }
+
+      out.resize(count);
+      validator.finish();
+    }
+    inline void index_structurals
+    (
+      char const * const json, std::size_t const size,
+      structural_index &out
+    )
+    {
+      no_validation none;
+      index_structurals(json, size, out, none);
+    }
+  }
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/thread_pool.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* A fixed set of worker threads which run parallel loops. The
+     * calling thread works, too, so a pool of one has no workers. */
+    class thread_pool
+    {
+      public:
+        /* Zero threads means one per core. */
+        explicit thread_pool(std::size_t threads = 0)
+        {
+          if(!threads)
+          { threads = std::max(1u, std::thread::hardware_concurrency()); }
+          for(std::size_t t{ 1 }; t < threads; ++t)
+          { workers_.emplace_back([this]{ work(); }); }
+        }
+        thread_pool(thread_pool const &) = delete;
+        thread_pool& operator =(thread_pool const &) = delete;
+        ~thread_pool()
+        {
+          {
+            std::lock_guard<std::mutex> const lock{ mutex_ };
+            stopping_ = true;
+          }
+          wake_.notify_all();
+          for(auto &worker : workers_)
+          { worker.join(); }
+        }
+
+        std::size_t size() const
+        { return workers_.size() + 1; }
+
+        /* Calls f(i) for every i in [0, count), spread across the pool,
+         * and returns once they're all done. The first exception thrown
+         * is rethrown here. */
+        template <typename F>
+        void run(std::size_t const count, F &&f)
+        {
+          if(workers_.empty() || count < 2)
+          {
+            for(std::size_t i{}; i < count; ++i)
+            { f(i); }
+            return;
+          }
+
+          {
+            std::lock_guard<std::mutex> const lock{ mutex_ };
+            job_ = std::ref(f);
+            count_ = count;
+            next_ = 0;
+            busy_ = workers_.size();
+            error_ = nullptr;
+            ++generation_;
+          }
+          wake_.notify_all();
+          steal();
+
+          std::unique_lock<std::mutex> lock{ mutex_ };
+          done_.wait(lock, [this]{ return !busy_; });
+          job_ = nullptr;
+          if(error_)
+          { std::rethrow_exception(error_); }
+        }
+
+      private:
+        /* Takes items until there are none left. */
+        void steal()
+        {
+          for(std::size_t i{ next_++ }; i < count_; i = next_++)
+          {
+            try
+            { job_(i); }
+            catch(...)
+            {
+              std::lock_guard<std::mutex> const lock{ mutex_ };
+              if(!error_)
+              { error_ = std::current_exception(); }
+              next_ = count_;
+            }
+          }
+        }
+
+        void work()
+        {
+          std::size_t seen{};
+          while(true)
+          {
+            {
+              std::unique_lock<std::mutex> lock{ mutex_ };
+              wake_.wait
+              (lock, [&]{ return stopping_ || generation_ != seen; });
+              if(stopping_)
+              { return; }
+              seen = generation_;
+            }
+
+            steal();
+
+            std::lock_guard<std::mutex> const lock{ mutex_ };
+            if(!--busy_)
+            { done_.notify_one(); }
+          }
+        }
+
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wake_, done_;
+        bool stopping_{};
+        std::size_t generation_{};
+
+        std::function<void (std::size_t)> job_;
+        std::size_t count_{};
+        std::atomic<std::size_t> next_{};
+        std::size_t busy_{};
+        std::exception_ptr error_;
+    };
+  }
+}
@@ -9,47 +9,240 @@
 
 #pragma once
 
-#include <boost/locale.hpp>
+#include <string>
+#include <cstdint>
+
+#include "simd.hpp"
 
 namespace jeayeson
 {
-  using str_citer = std::string::const_iterator;
-
   namespace detail
   {
-    inline int hex_to_num(char const c)
+    namespace utf
     {
-      if(c >= '0' && c <= '9')
-      { return c - '0'; }
-      else if(c >= 'a' && c <= 'f')
-      { return c - 'a' + 10; }
-      else if(c >= 'A' && c <= 'F')
-      { return c - 'A' + 10; }
-      return -1;
+      /* Hex digits to their values; everything else to -1. */
+      struct hex_table_t
+      {
+        constexpr hex_table_t()
+          : values{}
+        {
+          for(int c{}; c < 256; ++c)
+          {
+            values[c] = (c >= '0' && c <= '9') ? c - '0' :
+                        (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                        (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+          }
+        }
+
+        signed char values[256];
+      };
+      static constexpr hex_table_t const hex_table{};
+
+      std::uint32_t constexpr const replacement{ 0xFFFD };
+
+      /* The four hex digits of an escape; negative if any aren't. */
+      inline std::int32_t hex4(char const * const it)
+      {
+        auto const digit([&](int const i)
+        { return std::int32_t{ hex_table.values[static_cast<unsigned char>(it[i])] }; });
+        std::int32_t const a{ digit(0) }, b{ digit(1) }, c{ digit(2) }, d{ digit(3) };
+        return (a | b | c | d) < 0 ? -1 : (a << 12) | (b << 8) | (c << 4) | d;
+      }
+
+      /* Pairs up surrogates as the UTF-16 units arrive; one which isn't
+       * part of a pair becomes U+FFFD. The UTF-8 is gathered on the
+       * stack and appended to the output in pieces, the last of which
+       * is appended by flush. */
+      class transcoder
+      {
+        public:
+          explicit transcoder(std::string &out)
+            : out_(out)
+          { }
+
+          void unit(std::uint32_t const u)
+          {
+            if(u - 0xD800 < 0x800)
+            {
+              if(u < 0xDC00)
+              {
+                if(high_)
+                { put(replacement); }
+                high_ = u;
+              }
+              else if(high_)
+              {
+                put(0x10000 + ((high_ - 0xD800) << 10) + (u - 0xDC00));
+                high_ = 0;
+              }
+              else
+              { put(replacement); }
+            }
+            else
+            {
+              if(high_)
+              {
+                put(replacement);
+                high_ = 0;
+              }
+              put(u);
+            }
+          }
+
+          void flush()
+          {
+            if(high_)
+            {
+              put(replacement);
+              high_ = 0;
+            }
+            out_.append(buffer_, size_);
+            size_ = 0;
+          }
+
+        private:
+          void put(std::uint32_t const cp)
+          {
+            if(size_ > sizeof(buffer_) - 4)
+            {
+              out_.append(buffer_, size_);
+              size_ = 0;
+            }
+
+            char * const b{ buffer_ + size_ };
+            if(cp < 0x80)
+            {
+              b[0] = static_cast<char>(cp);
+              size_ += 1;
+            }
+            else if(cp < 0x800)
+            {
+              b[0] = static_cast<char>(0xC0 | (cp >> 6));
+              b[1] = static_cast<char>(0x80 | (cp & 0x3F));
+              size_ += 2;
+            }
+            else if(cp < 0x10000)
+            {
+              b[0] = static_cast<char>(0xE0 | (cp >> 12));
+              b[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+              b[2] = static_cast<char>(0x80 | (cp & 0x3F));
+              size_ += 3;
+            }
+            else
+            {
+              b[0] = static_cast<char>(0xF0 | (cp >> 18));
+              b[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+              b[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+              b[3] = static_cast<char>(0x80 | (cp & 0x3F));
+              size_ += 4;
+            }
+          }
+
+          std::string &out_;
+          std::uint32_t high_{};
+          char buffer_[256];
+          std::size_t size_{};
+      };
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+      /* Two escapes from 16 bytes of input, both checked and decoded
+       * at once; false if they aren't two escapes. */
+      __attribute__((target("sse2")))
+      inline bool two_escapes_sse2(char const * const it, std::uint32_t * const units)
+      {
+        __m128i const v
+        { _mm_loadu_si128(reinterpret_cast<__m128i const*>(it)) };
+
+        /* \u at 0 and 6, hex digits at 2-5 and 8-11. */
+        __m128i const pattern
+        { _mm_setr_epi8('\\', 'u', 0, 0, 0, 0, '\\', 'u', 0, 0, 0, 0, 0, 0, 0, 0) };
+        int const prefix
+        { _mm_movemask_epi8(_mm_cmpeq_epi8(v, pattern)) & 0x00C3 };
+
+        __m128i const digit{ _mm_sub_epi8(v, _mm_set1_epi8('0')) };
+        __m128i const is_digit
+        { _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit) };
+        __m128i const alpha
+        {
+          _mm_sub_epi8
+          (_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'))
+        };
+        __m128i const is_alpha
+        { _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha) };
+        int const hex
+        { _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) & 0x0F3C };
+        if(prefix != 0x00C3 || hex != 0x0F3C)
+        { return false; }
+
+        __m128i const nibbles
+        {
+          _mm_or_si128
+          (
+            _mm_and_si128(is_digit, digit),
+            _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10)))
+          )
+        };
+
+        /* Widened to 16 bits, then weighted and summed in pairs. */
+        __m128i const zero{ _mm_setzero_si128() };
+        __m128i const first
+        {
+          _mm_madd_epi16
+          (
+            _mm_unpacklo_epi8(nibbles, zero),
+            _mm_setr_epi16(0, 0, 4096, 256, 16, 1, 0, 0)
+          )
+        };
+        __m128i const second
+        {
+          _mm_madd_epi16
+          (
+            _mm_unpackhi_epi8(nibbles, zero),
+            _mm_setr_epi16(4096, 256, 16, 1, 0, 0, 0, 0)
+          )
+        };
+        __m128i const sums
+        {
+          _mm_add_epi32
+          (
+            _mm_unpacklo_epi64(_mm_srli_si128(first, 4), second),
+            _mm_unpacklo_epi64(_mm_srli_si128(first, 8), _mm_srli_si128(second, 4))
+          )
+        };
+        units[0] = static_cast<std::uint32_t>(_mm_cvtsi128_si32(sums));
+        units[1] = static_cast<std::uint32_t>
+        (_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+        return true;
+      }
+#endif
     }
 
-    inline auto utf16_to_8(str_citer it)
+    /* Decodes a run of \uXXXX escapes, starting at it, straight into
+     * out. Returns the last character consumed. */
+    inline char const* utf16_to_8
+    (char const *it, char const * const end, std::string &out)
     {
-      std::u16string u16;
-      for( ; *it && std::equal(it, it + 2, "\\u");)
+      utf::transcoder t{ out };
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+      if(simd::isa() != simd::isa_t::scalar)
       {
-        it += 2;
-        int const ch
+        std::uint32_t units[2];
+        while(end - it >= 16 && utf::two_escapes_sse2(it, units))
         {
-          (hex_to_num(*it++) << 12) +
-          (hex_to_num(*it++) << 8) +
-          (hex_to_num(*it++) << 4) +
-          (hex_to_num(*it++))
-        };
-        u16.push_back(ch);
+          t.unit(units[0]);
+          t.unit(units[1]);
+          it += 12;
+        }
       }
+#endif
 
-      /* XXX: Would be nice to use <codecvt> for this. */
-      return std::tuple<str_citer, std::string>
+      for( ; end - it > 5 && it[0] == '\\' && it[1] == 'u'; it += 6)
       {
-        --it,
-        boost::locale::conv::utf_to_utf<char>(u16)
-      };
+        std::int32_t const u{ utf::hex4(it + 2) };
+        t.unit(u < 0 ? utf::replacement : static_cast<std::uint32_t>(u));
+      }
+      t.flush();
+      return it - 1;
     }
   }
 }
@@ -0,0 +1,389 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/utf8.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "simd.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* Fed the same 64 byte blocks as the structural scan, so checking
+     * costs nothing when it's not asked for. */
+    struct no_validation
+    {
+      void blocks(char const *, std::size_t)
+      { }
+      void finish()
+      { }
+    };
+
+    namespace utf8
+    {
+      /* A byte at a time, with a shortcut over runs of ASCII. The state
+       * carries a partial sequence from one block to the next. */
+      class scalar_t
+      {
+        public:
+          void blocks(char const * const in, std::size_t const count)
+          {
+            auto const * const bytes(reinterpret_cast<unsigned char const*>(in));
+            std::size_t const size{ count * simd::block_size };
+            for(std::size_t i{}; i < size; )
+            {
+              if(!need_ && size - i >= 8)
+              {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, 8);
+                if(!(word & 0x8080808080808080ULL))
+                {
+                  i += 8;
+                  continue;
+                }
+              }
+              next(bytes[i++]);
+            }
+          }
+
+          bool valid() const
+          { return !error_ && !need_; }
+
+        private:
+          void next(unsigned char const c)
+          {
+            if(need_)
+            {
+              if(c < lo_ || c > hi_)
+              { error_ = true; }
+              lo_ = 0x80;
+              hi_ = 0xBF;
+              --need_;
+            }
+            else if(c < 0x80)
+            { }
+            else if(c >= 0xC2 && c <= 0xDF)
+            { expect(1, 0x80, 0xBF); }
+            else if(c == 0xE0) /* Overlong. */
+            { expect(2, 0xA0, 0xBF); }
+            else if(c == 0xED) /* Surrogates. */
+            { expect(2, 0x80, 0x9F); }
+            else if(c >= 0xE1 && c <= 0xEF)
+            { expect(2, 0x80, 0xBF); }
+            else if(c == 0xF0) /* Overlong. */
+            { expect(3, 0x90, 0xBF); }
+            else if(c >= 0xF1 && c <= 0xF3)
+            { expect(3, 0x80, 0xBF); }
+            else if(c == 0xF4) /* Past U+10FFFF. */
+            { expect(3, 0x80, 0x8F); }
+            else
+            { error_ = true; }
+          }
+
+          void expect
+          (int const need, unsigned char const lo, unsigned char const hi)
+          {
+            need_ = need;
+            lo_ = lo;
+            hi_ = hi;
+          }
+
+          int need_{};
+          unsigned char lo_{ 0x80 }, hi_{ 0xBF };
+          bool error_{};
+      };
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+      /* Each pair of adjacent bytes is checked against three 16 entry
+       * tables, indexed by the high nibble of the first byte, its low
+       * nibble, and the high nibble of the second; a bit which survives
+       * all three is an error. See Keiser and Lemire, "Validating UTF-8
+       * in less than one instruction per byte". */
+      std::uint8_t constexpr const too_short{ 1 << 0 };
+      std::uint8_t constexpr const too_long{ 1 << 1 };
+      std::uint8_t constexpr const overlong_3{ 1 << 2 };
+      std::uint8_t constexpr const too_large{ 1 << 3 };
+      std::uint8_t constexpr const surrogate{ 1 << 4 };
+      std::uint8_t constexpr const overlong_2{ 1 << 5 };
+      std::uint8_t constexpr const too_large_1000{ 1 << 6 };
+      std::uint8_t constexpr const overlong_4{ 1 << 6 };
+      std::uint8_t constexpr const two_conts{ 1 << 7 };
+      std::uint8_t constexpr const carry{ too_short | too_long | two_conts };
+
+      __attribute__((target("avx2")))
+      inline __m256i table_avx2
+      (
+        std::uint8_t const t0, std::uint8_t const t1, std::uint8_t const t2,
+        std::uint8_t const t3, std::uint8_t const t4, std::uint8_t const t5,
+        std::uint8_t const t6, std::uint8_t const t7, std::uint8_t const t8,
+        std::uint8_t const t9, std::uint8_t const t10, std::uint8_t const t11,
+        std::uint8_t const t12, std::uint8_t const t13, std::uint8_t const t14,
+        std::uint8_t const t15
+      )
+      {
+        return _mm256_setr_epi8
+        (
+          t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15,
+          t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15
+        );
+      }
+
+      /* The state is kept in memory between calls, so the validator
+       * can be made without AVX2 instructions on any hardware. */
+      class avx2_t
+      {
+        public:
+          __attribute__((target("avx2")))
+          void blocks(char const *in, std::size_t const count)
+          {
+            __m256i error{ load(error_) };
+            __m256i prev_input{ load(prev_) };
+            __m256i prev_incomplete{ load(prev_incomplete_) };
+            for(std::size_t b{}; b < count; ++b, in += simd::block_size)
+            {
+              __m256i const lo
+              { _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in)) };
+              __m256i const hi
+              { _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + 32)) };
+
+              /* Most blocks are ASCII; they only need to not follow a
+               * partial sequence. */
+              if(!_mm256_movemask_epi8(_mm256_or_si256(lo, hi)))
+              {
+                error = _mm256_or_si256(error, prev_incomplete);
+                prev_input = _mm256_setzero_si256();
+                prev_incomplete = _mm256_setzero_si256();
+                continue;
+              }
+
+              check(lo, prev_input, error);
+              check(hi, lo, error);
+              prev_input = hi;
+              prev_incomplete = incomplete(hi);
+            }
+            store(error_, error);
+            store(prev_, prev_input);
+            store(prev_incomplete_, prev_incomplete);
+          }
+
+          __attribute__((target("avx2")))
+          bool valid() const
+          {
+            __m256i const error
+            { _mm256_or_si256(load(error_), load(prev_incomplete_)) };
+            return _mm256_testz_si256(error, error);
+          }
+
+        private:
+          __attribute__((target("avx2")))
+          static __m256i load(std::uint8_t const * const from)
+          { return _mm256_load_si256(reinterpret_cast<__m256i const*>(from)); }
+          __attribute__((target("avx2")))
+          static void store(std::uint8_t * const to, __m256i const v)
+          { _mm256_store_si256(reinterpret_cast<__m256i*>(to), v); }
+
+          /* The input shifted right by n bytes, with the end of prev
+           * shifted in. */
+          template <int N>
+          __attribute__((target("avx2")))
+          static __m256i prev(__m256i const input, __m256i const prev)
+          {
+            return _mm256_alignr_epi8
+            (input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+          }
+
+          __attribute__((target("avx2")))
+          static __m256i high_nibble(__m256i const v)
+          {
+            return _mm256_and_si256
+            (_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+          }
+
+          __attribute__((target("avx2")))
+          static void check
+          (__m256i const input, __m256i const prev_input, __m256i &error)
+          {
+            __m256i const prev1{ prev<1>(input, prev_input) };
+
+            __m256i const byte_1_high
+            {
+              _mm256_shuffle_epi8
+              (
+                table_avx2
+                (
+                  too_long, too_long, too_long, too_long,
+                  too_long, too_long, too_long, too_long,
+                  two_conts, two_conts, two_conts, two_conts,
+                  too_short | overlong_2,
+                  too_short,
+                  too_short | overlong_3 | surrogate,
+                  too_short | too_large | too_large_1000 | overlong_4
+                ),
+                high_nibble(prev1)
+              )
+            };
+            __m256i const byte_1_low
+            {
+              _mm256_shuffle_epi8
+              (
+                table_avx2
+                (
+                  carry | overlong_3 | overlong_2 | overlong_4,
+                  carry | overlong_2,
+                  carry,
+                  carry,
+                  carry | too_large,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000 | surrogate,
+                  carry | too_large | too_large_1000,
+                  carry | too_large | too_large_1000
+                ),
+                _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F))
+              )
+            };
+            __m256i const byte_2_high
+            {
+              _mm256_shuffle_epi8
+              (
+                table_avx2
+                (
+                  too_short, too_short, too_short, too_short,
+                  too_short, too_short, too_short, too_short,
+                  too_long | overlong_2 | two_conts | overlong_3 |
+                    too_large_1000 | overlong_4,
+                  too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                  too_long | overlong_2 | two_conts | surrogate | too_large,
+                  too_long | overlong_2 | two_conts | surrogate | too_large,
+                  too_short, too_short, too_short, too_short
+                ),
+                high_nibble(input)
+              )
+            };
+            __m256i const special
+            {
+              _mm256_and_si256
+              (_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high)
+            };
+
+            /* The third and fourth bytes of a sequence are only flagged
+             * as two continuations in a row; they must be exactly that. */
+            __m256i const must_be_continuation
+            {
+              _mm256_and_si256
+              (
+                _mm256_or_si256
+                (
+                  _mm256_subs_epu8
+                  (prev<2>(input, prev_input), _mm256_set1_epi8(char(0xE0 - 0x80))),
+                  _mm256_subs_epu8
+                  (prev<3>(input, prev_input), _mm256_set1_epi8(char(0xF0 - 0x80)))
+                ),
+                _mm256_set1_epi8(char(0x80))
+              )
+            };
+            error = _mm256_or_si256
+            (error, _mm256_xor_si256(must_be_continuation, special));
+          }
+
+          /* Set where the last few bytes start a sequence which can't
+           * be finished within the block. */
+          __attribute__((target("avx2")))
+          static __m256i incomplete(__m256i const input)
+          {
+            __m256i const max
+            {
+              _mm256_setr_epi8
+              (
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1)
+              )
+            };
+            return _mm256_subs_epu8(input, max);
+          }
+
+          alignas(32) std::uint8_t error_[32]{};
+          alignas(32) std::uint8_t prev_[32]{};
+          alignas(32) std::uint8_t prev_incomplete_[32]{};
+      };
+#endif
+    }
+
+    /* Checks that the input is UTF-8, block by block, with the best
+     * available instruction set; finish throws if it isn't. */
+    class utf8_validator
+    {
+      public:
+        utf8_validator()
+          : avx2_{ simd::isa() == simd::isa_t::avx2 }
+        { }
+
+        void blocks(char const * const in, std::size_t const count)
+        {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+          if(avx2_)
+          { return vector_.blocks(in, count); }
+#endif
+          scalar_.blocks(in, count);
+        }
+
+        bool valid() const
+        {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+          if(avx2_)
+          { return vector_.valid(); }
+#endif
+          return scalar_.valid();
+        }
+
+        void finish() const
+        {
+          if(!valid())
+          { throw std::runtime_error{ "invalid utf-8 in input" }; }
+        }
+
+      private:
+        bool const avx2_;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        utf8::avx2_t vector_;
+#endif
+        utf8::scalar_t scalar_;
+    };
+
+    /* Just the check, without indexing anything. */
+    inline bool is_utf8(char const * const json, std::size_t const size)
+    {
+      utf8_validator v;
+      std::size_t const whole{ size / simd::block_size };
+      v.blocks(json, whole);
+
+      std::size_t const tail{ size % simd::block_size };
+      if(tail)
+      {
+        char padded[simd::block_size];
+        std::memset(padded, ' ', simd::block_size);
+        std::memcpy(padded, json + size - tail, tail);
+        v.blocks(padded, 1);
+      }
+      return v.valid();
+    }
+  }
+}
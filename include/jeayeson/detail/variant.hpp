@@ -0,0 +1,66 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: detail/variant.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <boost/variant.hpp>
+
+#include "config.hpp"
+#include "../compact_variant.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    template <typename Config, typename E = void>
+    struct variant_impl
+    {
+      template <typename... Ts>
+      using type = boost::variant<Ts...>;
+    };
+    template <typename Config>
+    struct variant_impl
+    <Config, void_t<typename Config::template variant_t<int, bool>>>
+    {
+      template <typename... Ts>
+      using type = typename Config::template variant_t<Ts...>;
+    };
+
+    /* The layout of a value, chosen by config's variant_t. */
+    template <typename... Ts>
+    using variant = typename variant_impl<config<config_tag>>::template type<Ts...>;
+
+    /* boost::get, or the same for a compact_variant. */
+    template <typename T, typename Variant>
+    T& get(Variant &v)
+    { return boost::get<T>(v); }
+    template <typename T, typename Variant>
+    T const& get(Variant const &v)
+    { return boost::get<T>(v); }
+    template <typename T, typename Variant>
+    T* get_if(Variant * const v)
+    { return boost::get<T>(v); }
+    template <typename T, typename Variant>
+    T const* get_if(Variant const * const v)
+    { return boost::get<T>(v); }
+
+    template <typename T, typename... Ts>
+    T& get(compact_variant<Ts...> &v)
+    { return v.template get<T>(); }
+    template <typename T, typename... Ts>
+    T const& get(compact_variant<Ts...> const &v)
+    { return v.template get<T>(); }
+    template <typename T, typename... Ts>
+    T* get_if(compact_variant<Ts...> * const v)
+    { return v->template get_if<T>(); }
+    template <typename T, typename... Ts>
+    T const* get_if(compact_variant<Ts...> const * const v)
+    { return v->template get_if<T>(); }
+  }
+}
@@ -0,0 +1,353 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: flat_map.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <initializer_list>
+
+#include "hash.hpp"
+#include "detail/simd.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    /* A bit for each of the 16 tags, from, which equals tag. */
+    __attribute__((target("sse2")))
+    inline unsigned match_tags_sse2(unsigned char const * const from, unsigned char const tag)
+    {
+      __m128i const tags{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(from)) };
+      return static_cast<unsigned>
+      (_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(static_cast<char>(tag)))));
+    }
+#endif
+  }
+
+  /* A map backend, for config's map_t, which keeps its entries in one
+   * vector, in the order they were added. Alongside, each entry has a
+   * one byte tag, taken from its key's hash. Small maps are searched by
+   * comparing 16 tags at a time and then only the keys whose tags match;
+   * past linear_max entries, an open-addressed index of positions is
+   * kept, too. Inserting, like pushing onto a vector, may move the
+   * entries; erasing is linear.
+   *
+   * Entries are std::pair<K, V>, rather than std::pair<K const, V>, so
+   * they can be moved around; changing a key through an iterator isn't
+   * allowed. */
+  template
+  <
+    typename K, typename V,
+    typename Alloc = std::allocator<std::pair<K, V>>,
+    typename Hash = fast_hash<K>
+  >
+  class flat_map
+  {
+    public:
+      using key_type = K;
+      using mapped_type = V;
+      using value_type = std::pair<K, V>;
+      using size_type = std::size_t;
+      using allocator_type = Alloc;
+      using entries_t = std::vector<value_type, Alloc>;
+      using iterator = typename entries_t::iterator;
+      using const_iterator = typename entries_t::const_iterator;
+
+      static size_type constexpr const linear_max{ 32 };
+
+      flat_map() = default;
+      flat_map(std::initializer_list<std::pair<K const, V>> const list)
+      { insert(list.begin(), list.end()); }
+
+      iterator begin()
+      { return entries_.begin(); }
+      const_iterator begin() const
+      { return entries_.begin(); }
+      const_iterator cbegin() const
+      { return entries_.begin(); }
+      iterator end()
+      { return entries_.end(); }
+      const_iterator end() const
+      { return entries_.end(); }
+      const_iterator cend() const
+      { return entries_.end(); }
+
+      size_type size() const
+      { return entries_.size(); }
+      bool empty() const
+      { return entries_.empty(); }
+
+      iterator find(K const &key)
+      {
+        size_type const i{ position(key, hash(key)) };
+        return i == npos ? end() : begin() + i;
+      }
+      const_iterator find(K const &key) const
+      {
+        size_type const i{ position(key, hash(key)) };
+        return i == npos ? end() : begin() + i;
+      }
+      size_type count(K const &key) const
+      { return find(key) != end(); }
+
+      /* With a transparent Hash, like fast_hash<std::string>, a key_view
+       * is found without making a K. */
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      iterator find(Q const &key)
+      {
+        size_type const i{ position(key, hash(key)) };
+        return i == npos ? end() : begin() + i;
+      }
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      const_iterator find(Q const &key) const
+      {
+        size_type const i{ position(key, hash(key)) };
+        return i == npos ? end() : begin() + i;
+      }
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      size_type count(Q const &key) const
+      { return find(key) != end(); }
+
+      V& operator [](K const &key)
+      { return try_emplace(key).first->second; }
+      V& at(K const &key)
+      {
+        auto const it(find(key));
+        if(it == end())
+        { throw std::out_of_range{ "no such key" }; }
+        return it->second;
+      }
+
+      template <typename... Args>
+      std::pair<iterator, bool> try_emplace(K const &key, Args &&...args)
+      {
+        std::size_t const h{ hash(key) };
+        size_type const i{ position(key, h) };
+        if(i != npos)
+        { return { begin() + i, false }; }
+        reserve_first();
+        entries_.emplace_back
+        (
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+        added(h);
+        return { end() - 1, true };
+      }
+      template <typename P>
+      std::pair<iterator, bool> emplace(P &&key, V value)
+      { return try_emplace(std::forward<P>(key), std::move(value)); }
+
+      /* Like std::map, an existing key keeps its value. */
+      template <typename P>
+      std::pair<iterator, bool> insert(P &&entry)
+      {
+        std::size_t const h{ hash(entry.first) };
+        size_type const i{ position(entry.first, h) };
+        if(i != npos)
+        { return { begin() + i, false }; }
+        reserve_first();
+        entries_.emplace_back(std::forward<P>(entry));
+        added(h);
+        return { end() - 1, true };
+      }
+      template <typename It>
+      void insert(It first, It const last)
+      {
+        for( ; first != last; ++first)
+        { insert(*first); }
+      }
+
+      size_type erase(K const &key)
+      {
+        size_type const i{ position(key, hash(key)) };
+        if(i == npos)
+        { return 0; }
+        erase(begin() + i);
+        return 1;
+      }
+      iterator erase(const_iterator const it)
+      {
+        size_type const i{ static_cast<size_type>(it - cbegin()) };
+        entries_.erase(entries_.begin() + i);
+        tags_.erase(tags_.begin() + i);
+        tags_.push_back(0); /* Still padded. */
+        reindex();
+        return begin() + i;
+      }
+
+      void clear()
+      {
+        entries_.clear();
+        tags_.clear();
+        index_.clear();
+      }
+
+      void swap(flat_map &other)
+      {
+        entries_.swap(other.entries_);
+        tags_.swap(other.tags_);
+        index_.swap(other.index_);
+      }
+
+      /* The same entries, in any order. */
+      friend bool operator ==(flat_map const &lhs, flat_map const &rhs)
+      {
+        if(lhs.size() != rhs.size())
+        { return false; }
+        for(auto const &entry : lhs)
+        {
+          auto const it(rhs.find(entry.first));
+          if(it == rhs.end() || !(it->second == entry.second))
+          { return false; }
+        }
+        return true;
+      }
+      friend bool operator !=(flat_map const &lhs, flat_map const &rhs)
+      { return !(lhs == rhs); }
+
+    private:
+      using bytes_t = std::vector
+      <
+        unsigned char,
+        typename std::allocator_traits<Alloc>::template rebind_alloc<unsigned char>
+      >;
+      using index_t = std::vector
+      <
+        std::uint32_t,
+        typename std::allocator_traits<Alloc>::template rebind_alloc<std::uint32_t>
+      >;
+
+      static size_type constexpr const npos{ static_cast<size_type>(-1) };
+
+      /* Both the tag and the index need well mixed bits, as fast_hash
+       * gives. */
+      template <typename Q>
+      std::size_t hash(Q const &key) const
+      { return hasher_(key); }
+
+      /* The top byte; the index uses the low bits. */
+      static unsigned char tag(std::size_t const h)
+      { return static_cast<unsigned char>(h >> (sizeof(std::size_t) * 8 - 8)); }
+
+      template <typename Q>
+      size_type position(Q const &key, std::size_t const h) const
+      {
+        if(!index_.empty())
+        { return indexed(key, h); }
+
+        unsigned char const t{ tag(h) };
+        size_type const n{ entries_.size() };
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        if(detail::simd::isa() != detail::simd::isa_t::scalar)
+        {
+          /* tags_ is padded to a multiple of 16. */
+          for(size_type base{}; base < n; base += 16)
+          {
+            unsigned matches{ detail::match_tags_sse2(tags_.data() + base, t) };
+            if(n - base < 16)
+            { matches &= (1u << (n - base)) - 1; }
+            while(matches)
+            {
+              size_type const i{ base + static_cast<size_type>(__builtin_ctz(matches)) };
+              if(entries_[i].first == key)
+              { return i; }
+              matches &= matches - 1;
+            }
+          }
+          return npos;
+        }
+#endif
+        for(size_type i{}; i < n; ++i)
+        {
+          if(tags_[i] == t && entries_[i].first == key)
+          { return i; }
+        }
+        return npos;
+      }
+
+      /* Slots hold a position plus one; zero is empty. */
+      template <typename Q>
+      size_type indexed(Q const &key, std::size_t const h) const
+      {
+        size_type const mask{ index_.size() - 1 };
+        unsigned char const t{ tag(h) };
+        for(size_type s{ h & mask }; index_[s]; s = (s + 1) & mask)
+        {
+          size_type const i{ index_[s] - 1u };
+          if(tags_[i] == t && entries_[i].first == key)
+          { return i; }
+        }
+        return npos;
+      }
+
+      /* Skips the smallest steps of the vector's growth. */
+      void reserve_first()
+      {
+        if(!entries_.capacity())
+        { entries_.reserve(4); }
+      }
+
+      void added(std::size_t const h)
+      {
+        size_type const n{ entries_.size() };
+        if(tags_.size() < n)
+        { tags_.resize(tags_.size() + 16); }
+        tags_[n - 1] = tag(h);
+
+        if(n <= linear_max)
+        { return; }
+        if(n * 2 > index_.size())
+        { reindex(); }
+        else
+        { place(h, n - 1); }
+      }
+
+      void place(std::size_t const h, size_type const i)
+      {
+        size_type const mask{ index_.size() - 1 };
+        size_type s{ h & mask };
+        while(index_[s])
+        { s = (s + 1) & mask; }
+        index_[s] = static_cast<std::uint32_t>(i + 1);
+      }
+
+      /* Keeps the index at most half full, or drops it once the map is
+       * small enough to scan. */
+      void reindex()
+      {
+        size_type const n{ entries_.size() };
+        if(n <= linear_max)
+        {
+          index_t{}.swap(index_);
+          return;
+        }
+
+        size_type slots{ 64 };
+        while(slots < n * 4)
+        { slots *= 2; }
+        index_.assign(slots, 0);
+        for(size_type i{}; i < n; ++i)
+        { place(hash(entries_[i].first), i); }
+      }
+
+      entries_t entries_;
+      bytes_t tags_;
+      index_t index_;
+      Hash hasher_;
+  };
+}
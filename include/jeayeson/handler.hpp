@@ -0,0 +1,57 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: handler.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+
+#include "span.hpp"
+#include "data.hpp"
+#include "file.hpp"
+#include "detail/parser.hpp"
+#include "detail/file_buffer.hpp"
+
+namespace jeayeson
+{
+  /* Receives the contents of a document, in order, without anything
+   * being built. Derive from this and hide only the events you need;
+   * handlers are passed by type, so the calls inline.
+   *
+   * Strings and keys are the parser's scratch buffer; they're only
+   * valid during the call, but may be swapped out. */
+  struct handler
+  {
+    void start_map(){}
+    void end_map(){}
+    void start_array(){}
+    void end_array(){}
+
+    void key(std::string &){}
+    void string(std::string &){}
+    void integer(detail::int_t){}
+    void real(detail::float_t){}
+    void boolean(bool){}
+    void null(){}
+  };
+
+  /* Reports the first map or array in the input to the handler; false
+   * if there isn't one. */
+  template <typename Handler>
+  bool parse(span const &json, Handler &h)
+  { return detail::parser::parse(json, h); }
+  template <typename Handler>
+  bool parse(data const &json, Handler &h)
+  { return parse(span{ json.data.data(), json.data.size() }, h); }
+  template <typename Handler>
+  bool parse(file const &f, Handler &h)
+  {
+    detail::file_buffer const buffer{ f.data };
+    return parse(buffer.get(), h);
+  }
+}
@@ -0,0 +1,150 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: hash.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <functional>
+
+#include "key_view.hpp"
+
+namespace jeayeson
+{
+  namespace detail
+  {
+    /* Valid when Hash can hash a Q itself, so a map can find one without
+     * making a key of it. */
+    template <typename Hash, typename Q>
+    using transparent_t = decltype
+    (
+      std::declval<typename Hash::is_transparent*>(),
+      std::declval<Hash const&>()(std::declval<Q const&>())
+    );
+
+    inline std::uint64_t mix(std::uint64_t h)
+    {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdull;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ull;
+      h ^= h >> 33;
+      return h;
+    }
+
+    inline std::uint64_t load64(char const * const data)
+    {
+      std::uint64_t word;
+      std::memcpy(&word, data, 8);
+      return word;
+    }
+    inline std::uint64_t load32(char const * const data)
+    {
+      std::uint32_t word;
+      std::memcpy(&word, data, 4);
+      return word;
+    }
+
+    /* Eight bytes at a time, multiplied in, then mixed. The last word
+     * overlaps the one before it, and shorter keys are read in at most
+     * two loads, so there's no loop over the tail. */
+    inline std::uint64_t hash_bytes(char const * const data, std::size_t const size)
+    {
+      std::uint64_t constexpr const k{ 0x9fb21c651e98df25ull };
+      std::uint64_t h{ 0x9e3779b97f4a7c15ull ^ (size * k) };
+      if(size >= 8)
+      {
+        for(std::size_t i{}; i + 8 < size; i += 8)
+        {
+          h = (h ^ load64(data + i)) * k;
+          h ^= h >> 32;
+        }
+        h = (h ^ load64(data + size - 8)) * k;
+      }
+      else if(size >= 4)
+      { h = (h ^ (load32(data) << 32 | load32(data + size - 4))) * k; }
+      else if(size)
+      {
+        auto const byte([&](std::size_t const i)
+        { return std::uint64_t{ static_cast<unsigned char>(data[i]) }; });
+        h = (h ^ (byte(0) << 16 | byte(size / 2) << 8 | byte(size - 1))) * k;
+      }
+      return mix(h);
+    }
+  }
+
+  template <typename K>
+  struct fast_hash;
+
+  /* A key, made once, along with its fast_hash, for looking up the same
+   * key over and over; json_key is one of these. flat_map and swiss_map
+   * use the hash as it is, so only the one candidate key is compared,
+   * and, with interned keys, only by pointer. Other maps just use the
+   * key. */
+  template <typename K>
+  class hashed_key
+  {
+    public:
+      explicit hashed_key(K key)
+        : key_{ std::move(key) }
+        , hash_{ fast_hash<K>{}(key_) }
+      { }
+
+      K const& key() const
+      { return key_; }
+      std::size_t hash() const
+      { return hash_; }
+
+      friend bool operator ==(K const &lhs, hashed_key const &rhs)
+      { return lhs == rhs.key_; }
+      friend bool operator ==(hashed_key const &lhs, K const &rhs)
+      { return lhs.key_ == rhs; }
+      friend bool operator <(K const &lhs, hashed_key const &rhs)
+      { return lhs < rhs.key_; }
+      friend bool operator <(hashed_key const &lhs, K const &rhs)
+      { return lhs.key_ < rhs; }
+
+    private:
+      K key_;
+      std::size_t hash_;
+  };
+
+  /* Hashes whose every bit is usable: std::hash is the identity for
+   * integers and pointers, and strings are hashed a word at a time.
+   * They're transparent, so maps can find a hashed_key without hashing
+   * it again. */
+  template <typename K>
+  struct fast_hash
+  {
+    using is_transparent = void;
+
+    std::size_t operator ()(K const &key) const
+    { return static_cast<std::size_t>(detail::mix(std::hash<K>{}(key))); }
+    std::size_t operator ()(hashed_key<K> const &key) const
+    { return key.hash(); }
+  };
+  /* A key_view or a C string is found without making a std::string of
+   * it, too. */
+  template <>
+  struct fast_hash<std::string>
+  {
+    using is_transparent = void;
+
+    std::size_t operator ()(std::string const &key) const
+    { return static_cast<std::size_t>(detail::hash_bytes(key.data(), key.size())); }
+    std::size_t operator ()(hashed_key<std::string> const &key) const
+    { return key.hash(); }
+    std::size_t operator ()(key_view const key) const
+    { return static_cast<std::size_t>(detail::hash_bytes(key.data(), key.size())); }
+    std::size_t operator ()(char const * const key) const
+    { return (*this)(key_view{ key }); }
+  };
+}
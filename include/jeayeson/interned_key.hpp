@@ -0,0 +1,187 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: interned_key.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <ostream>
+#include <functional>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "key_view.hpp"
+
+namespace jeayeson
+{
+  /* Keeps one copy of each distinct key, for the life of the program.
+   * Interning is safe from several threads at once; the pool is split
+   * into shards, by hash, each with its own lock. Since nothing is ever
+   * removed, it suits inputs with a bounded set of keys, not untrusted
+   * input with arbitrary ones. */
+  class key_pool
+  {
+    public:
+      static key_pool& global()
+      {
+        static key_pool pool;
+        return pool;
+      }
+
+      /* The one copy of the given key; a hit doesn't allocate. */
+      std::string const* intern(char const * const data, std::size_t const size)
+      {
+        std::size_t const h{ hash(data, size) };
+        shard &s(shards_[h % shard_count]);
+        std::lock_guard<std::mutex> const lock{ s.mutex };
+
+        if(std::string const * const key = scan(s, h, data, size))
+        { return key; }
+        return s.keys.emplace
+        (h, std::make_unique<std::string const>(data, size))->second.get();
+      }
+
+      /* The one copy of the given key, if there is one yet; this
+       * doesn't add it, so it never allocates. */
+      std::string const* find(char const * const data, std::size_t const size)
+      {
+        std::size_t const h{ hash(data, size) };
+        shard &s(shards_[h % shard_count]);
+        std::lock_guard<std::mutex> const lock{ s.mutex };
+        return scan(s, h, data, size);
+      }
+
+      /* The number of distinct keys. */
+      std::size_t size()
+      {
+        std::size_t n{};
+        for(auto &s : shards_)
+        {
+          std::lock_guard<std::mutex> const lock{ s.mutex };
+          n += s.keys.size();
+        }
+        return n;
+      }
+
+    private:
+      static std::size_t constexpr const shard_count{ 16 };
+
+      /* FNV-1a. */
+      static std::size_t hash(char const * const data, std::size_t const size)
+      {
+        std::uint64_t h{ 14695981039346656037ull };
+        for(std::size_t i{}; i < size; ++i)
+        {
+          h ^= static_cast<unsigned char>(data[i]);
+          h *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(h);
+      }
+
+      struct shard
+      {
+        std::mutex mutex;
+        std::unordered_multimap
+        <std::size_t, std::unique_ptr<std::string const>> keys;
+      };
+
+      /* The caller holds the shard's lock. */
+      static std::string const* scan
+      (shard &s, std::size_t const h, char const * const data, std::size_t const size)
+      {
+        auto const range(s.keys.equal_range(h));
+        for(auto it(range.first); it != range.second; ++it)
+        {
+          std::string const &key{ *it->second };
+          if(key.size() == size && !std::memcmp(key.data(), data, size))
+          { return &key; }
+        }
+        return nullptr;
+      }
+
+      shard shards_[shard_count];
+  };
+
+  /* A map key which is a pointer into the global key_pool, for use as
+   * key_t in config.hpp. Each map entry then holds a pointer, rather
+   * than its own string, and keys are equal only if the pointers are.
+   * Ordering is still by the strings, so maps print in the same order.
+   * Making one from a string interns it. */
+  class interned_key
+  {
+    public:
+      interned_key()
+        : interned_key{ "", 0 }
+      { }
+      interned_key(char const * const data, std::size_t const size)
+        : str_{ key_pool::global().intern(data, size) }
+      { }
+      interned_key(char const * const str)
+        : interned_key{ str, std::strlen(str) }
+      { }
+      interned_key(std::string const &str)
+        : interned_key{ str.data(), str.size() }
+      { }
+
+      /* The key for the given string, unless it's never been interned,
+       * in which case no map has it. Finding a key_view in a map this
+       * way doesn't allocate. */
+      static boost::optional<interned_key> existing(key_view const key)
+      {
+        std::string const * const str
+        { key_pool::global().find(key.data(), key.size()) };
+        if(!str)
+        { return boost::none; }
+        return interned_key{ str };
+      }
+
+      std::string const& str() const
+      { return *str_; }
+      operator std::string const&() const
+      { return *str_; }
+      char const* c_str() const
+      { return str_->c_str(); }
+      std::size_t size() const
+      { return str_->size(); }
+      bool empty() const
+      { return str_->empty(); }
+
+      friend bool operator ==(interned_key const &lhs, interned_key const &rhs)
+      { return lhs.str_ == rhs.str_; }
+      friend bool operator !=(interned_key const &lhs, interned_key const &rhs)
+      { return lhs.str_ != rhs.str_; }
+      friend bool operator <(interned_key const &lhs, interned_key const &rhs)
+      { return lhs.str_ != rhs.str_ && *lhs.str_ < *rhs.str_; }
+      friend std::ostream& operator <<(std::ostream &stream, interned_key const &key)
+      { return stream << *key.str_; }
+
+    private:
+      friend struct std::hash<interned_key>;
+
+      explicit interned_key(std::string const * const str)
+        : str_{ str }
+      { }
+
+      std::string const *str_;
+  };
+}
+
+namespace std
+{
+  template <>
+  struct hash<jeayeson::interned_key>
+  {
+    std::size_t operator ()(jeayeson::interned_key const &key) const
+    { return std::hash<std::string const*>{}(key.str_); }
+  };
+}
@@ -0,0 +1,90 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: key_view.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <ostream>
+#include <algorithm>
+
+namespace jeayeson
+{
+  /* A key to look up, which refers to the caller's characters instead
+   * of copying them, like C++17's std::string_view. Maps take these, and
+   * string literals, wherever they take a key, and finding one doesn't
+   * allocate. It's made from a std::string only explicitly, so that
+   * lookups with a key_t still use the key_t. */
+  class key_view
+  {
+    public:
+      key_view(char const * const data, std::size_t const size)
+        : data_{ data }
+        , size_{ size }
+      { }
+      key_view(char const * const str)
+        : key_view{ str, std::strlen(str) }
+      { }
+      explicit key_view(std::string const &str)
+        : key_view{ str.data(), str.size() }
+      { }
+
+      char const* data() const
+      { return data_; }
+      std::size_t size() const
+      { return size_; }
+      bool empty() const
+      { return !size_; }
+      std::string str() const
+      { return std::string(data_, size_); }
+
+      /* Ordered as std::string is. */
+      static int compare(key_view const lhs, key_view const rhs)
+      {
+        std::size_t const n{ std::min(lhs.size_, rhs.size_) };
+        int const c{ n ? std::memcmp(lhs.data_, rhs.data_, n) : 0 };
+        if(c)
+        { return c; }
+        return lhs.size_ < rhs.size_ ? -1 : lhs.size_ > rhs.size_ ? 1 : 0;
+      }
+
+      friend bool operator ==(key_view const lhs, key_view const rhs)
+      {
+        return lhs.size_ == rhs.size_ &&
+               (!lhs.size_ || !std::memcmp(lhs.data_, rhs.data_, lhs.size_));
+      }
+      friend bool operator !=(key_view const lhs, key_view const rhs)
+      { return !(lhs == rhs); }
+      friend bool operator <(key_view const lhs, key_view const rhs)
+      { return compare(lhs, rhs) < 0; }
+
+      /* Against stored keys; anything convertible to a std::string
+       * const&, such as an interned_key, works too. */
+      friend bool operator ==(std::string const &lhs, key_view const rhs)
+      { return key_view{ lhs } == rhs; }
+      friend bool operator ==(key_view const lhs, std::string const &rhs)
+      { return lhs == key_view{ rhs }; }
+      friend bool operator !=(std::string const &lhs, key_view const rhs)
+      { return !(lhs == rhs); }
+      friend bool operator !=(key_view const lhs, std::string const &rhs)
+      { return !(lhs == rhs); }
+      friend bool operator <(std::string const &lhs, key_view const rhs)
+      { return compare(key_view{ lhs }, rhs) < 0; }
+      friend bool operator <(key_view const lhs, std::string const &rhs)
+      { return compare(lhs, key_view{ rhs }) < 0; }
+
+      friend std::ostream& operator <<(std::ostream &stream, key_view const key)
+      { return stream.write(key.data_, static_cast<std::streamsize>(key.size_)); }
+
+    private:
+      char const *data_;
+      std::size_t size_;
+  };
+}
@@ -0,0 +1,18 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: lazy.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+namespace jeayeson
+{
+  /* Asks for nested maps and arrays to be kept as raw JSON, and only
+   * parsed the first time they're touched. */
+  struct lazy
+  { };
+}
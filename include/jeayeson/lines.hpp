@@ -0,0 +1,171 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: lines.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "span.hpp"
+#include "data.hpp"
+#include "file.hpp"
+#include "projection.hpp"
+#include "detail/document.hpp"
+#include "detail/projection.hpp"
+#include "detail/parser_util.hpp"
+#include "detail/file_buffer.hpp"
+#include "detail/thread_pool.hpp"
+
+namespace jeayeson
+{
+  /* JSON Lines (NDJSON): one value per line. The input is cut into
+   * chunks at line breaks, the chunks are parsed across a pool of
+   * threads, and the records are handed back in their original order.
+   *
+   *   json_lines const log{ json_file{ "events.ndjson" } };
+   *   log.for_each([](json_value &record){ ... });
+   */
+  template <typename Value, typename Parser>
+  class lines
+  {
+    public:
+      using map_t = map<Value, Parser>;
+      using value_type = Value;
+      using parser_t = Parser;
+
+      /* Chunks are at least this big, so each is worth a thread. */
+      static std::size_t constexpr const chunk_size{ 1 << 20 };
+
+      lines(data const &json)
+        : owned_{ json.data }
+        , json_{ owned_.data(), owned_.size() }
+      { }
+      /* The span must outlive the reader. */
+      lines(span const &json)
+        : json_{ json }
+      { }
+      lines(file const &f)
+        : buffer_{ new detail::file_buffer{ f.data } }
+        , json_{ buffer_->get() }
+      { }
+      /* Only the given paths of each record are parsed. */
+      lines(data const &json, projection const &p)
+        : lines{ json }
+      { paths_.reset(new detail::path_tree{ p }); }
+      lines(span const &json, projection const &p)
+        : lines{ json }
+      { paths_.reset(new detail::path_tree{ p }); }
+      lines(file const &f, projection const &p)
+        : lines{ f }
+      { paths_.reset(new detail::path_tree{ p }); }
+      /* json_ may point into owned_. */
+      lines(lines const &) = delete;
+      lines& operator =(lines const &) = delete;
+
+      /* Calls f(Value&) with each record, in order. Zero threads means
+       * one per core. Only a few chunks are held at once, so the whole
+       * input is never in memory as values. */
+      template <typename F>
+      void for_each(F &&f, std::size_t const threads = 0) const
+      {
+        detail::thread_pool pool{ threads };
+        std::vector<span> const chunks{ split() };
+        std::size_t const batch{ pool.size() * 2 };
+        std::vector<std::vector<Value>> parsed(batch);
+
+        for(std::size_t b{}; b < chunks.size(); b += batch)
+        {
+          std::size_t const count{ std::min(batch, chunks.size() - b) };
+          pool.run(count, [&](std::size_t const c)
+          {
+            parsed[c].clear();
+            parse_chunk(chunks[b + c], parsed[c]);
+          });
+
+          for(std::size_t c{}; c < count; ++c)
+          {
+            for(auto &record : parsed[c])
+            { f(record); }
+          }
+        }
+      }
+
+      /* Every record, in order. */
+      std::vector<Value> get(std::size_t const threads = 0) const
+      {
+        std::vector<Value> records;
+        for_each([&](Value &record){ records.push_back(std::move(record)); }, threads);
+        return records;
+      }
+
+    private:
+      /* A raw line break is never within a string, since those must be
+       * escaped, so chunks only need to end just past one. */
+      std::vector<span> split() const
+      {
+        std::vector<span> chunks;
+        char const *it{ json_.data };
+        char const * const end{ json_.data + json_.size };
+        while(it != end)
+        {
+          char const *stop{ end };
+          if(static_cast<std::size_t>(end - it) > chunk_size)
+          {
+            void const * const newline
+            { std::memchr(it + chunk_size, '\n', end - it - chunk_size) };
+            if(newline)
+            { stop = static_cast<char const*>(newline) + 1; }
+          }
+          chunks.push_back({ it, static_cast<std::size_t>(stop - it) });
+          it = stop;
+        }
+        return chunks;
+      }
+
+      /* Every value in the chunk is a record, whatever lines it's on. */
+      void parse_chunk(span const &chunk, std::vector<Value> &out) const
+      {
+        detail::document const doc{ chunk };
+        for(std::size_t i{}; i < doc.count(); )
+        {
+          char const c{ doc.at(i) };
+          if(c == ',' || c == ':')
+          {
+            ++i;
+            continue;
+          }
+          else if(!detail::starts_value(c))
+          { throw std::runtime_error{ "invalid record" }; }
+
+          out.emplace_back();
+          if(paths_ && c == map_t::delim_open)
+          {
+            out.back() = map_t{};
+            detail::project(out.back().template as<map_t>(), doc, i, *paths_);
+            i = doc.skip(i);
+          }
+          else
+          {
+            detail::builder<Value, Parser> b{ out.back() };
+            i = Parser::parse(b, chunk.data, chunk.size, doc.index, i);
+          }
+        }
+      }
+
+      std::string owned_;
+      std::unique_ptr<detail::file_buffer> buffer_;
+      span json_;
+      std::unique_ptr<detail::path_tree const> paths_;
+  };
+}
@@ -12,12 +12,19 @@
 #include "detail/normalize.hpp"
 #include "detail/config.hpp"
 #include "detail/tokenize.hpp"
+#include "detail/lookup.hpp"
 #include "file.hpp"
 #include "data.hpp"
+#include "span.hpp"
+#include "lazy.hpp"
+#include "validate.hpp"
+#include "projection.hpp"
 
 #include <string>
 #include <vector>
 #include <utility>
+#include <iterator>
+#include <algorithm>
 #include <initializer_list>
 
 namespace jeayeson
@@ -35,7 +42,7 @@ namespace jeayeson
     public:
       using map_t = map<Value, Parser>;
       using array_t = array<Value, Parser>;
-      using key_t = std::string;
+      using key_t = detail::key_t;
       using value_type = Value;
       using parser_t = Parser;
       using internal_map_t = config<config_tag>::map_t<key_t, Value>;
@@ -46,17 +53,44 @@ namespace jeayeson
       static char const delim_close = '}';
 
       map(){} /* XXX: User-defined ctor required for variant. */
-      map(map const &m)
-        : values_{ m.values_ }
-      { }
+      /* Moves mustn't throw, or the variant will copy to the heap as a
+       * backup on every assignment. */
+      map(map const &) = default;
+      map(map &&) noexcept = default;
+      map& operator =(map const &) = default;
+      map& operator =(map &&) noexcept = default;
       map(data const &json)
       { reset(json); }
       map(std::string const &json)
       { reset(json); }
       map(file const &f)
       { reset(f); }
-      template <typename T>
-      map(std::map<key_t, T> const &container)
+      map(span const &json)
+      { reset(json); }
+      /* Invalid UTF-8 in the input throws. */
+      map(data const &json, validate const &v)
+      { reset(json, v); }
+      map(span const &json, validate const &v)
+      { reset(json, v); }
+      map(file const &f, validate const &v)
+      { reset(f, v); }
+      /* Nested maps and arrays are parsed when first touched. */
+      map(data const &json, lazy const &l)
+      { reset(json, l); }
+      map(span const &json, lazy const &l)
+      { reset(json, l); }
+      map(file const &f, lazy const &l)
+      { reset(f, l); }
+      /* Only the given paths are parsed. */
+      map(data const &json, projection const &p)
+      { reset(json, p); }
+      map(span const &json, projection const &p)
+      { reset(json, p); }
+      map(file const &f, projection const &p)
+      { reset(f, p); }
+      /* Keys may be anything key_t can be made from. */
+      template <typename K, typename T>
+      map(std::map<K, T> const &container)
       {
         for(auto const &it : container)
         { set(it.first, it.second); }
@@ -82,10 +116,79 @@ namespace jeayeson
         { return static_cast<detail::normalize<T>>(fallback); }
       }
 
+      /* String literals and key_views are found without making a key_t,
+       * where the backend allows; see detail::find_key. A missing key
+       * is added, as above. */
+      template <typename T = Value, typename K, typename = detail::if_key_view<K>>
+      auto& get(K const &key)
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        return get<T>(make_key(key));
+      }
+      template <typename T = Value, typename K, typename = detail::if_key_view<K>>
+      auto const& get(K const &key) const
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        return get<T>(make_key(key));
+      }
+
+      template <typename T = Value, typename K, typename = detail::if_key_view<K>>
+      auto get(K const &key, T &&fallback) const
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        else
+        { return static_cast<detail::normalize<T>>(fallback); }
+      }
+
+      /* A json_key isn't hashed again, where the backend hashes; see
+       * detail::find_key. A missing key is added, as above. */
+      template <typename T = Value>
+      auto& get(hashed_key<key_t> const &key)
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        return get<T>(key.key());
+      }
+      template <typename T = Value>
+      auto const& get(hashed_key<key_t> const &key) const
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        return get<T>(key.key());
+      }
+
+      template <typename T = Value>
+      auto get(hashed_key<key_t> const &key, T &&fallback) const
+      {
+        auto const it(find(key));
+        if(it != values_.end())
+        { return it->second.template as<T>(); }
+        else
+        { return static_cast<detail::normalize<T>>(fallback); }
+      }
+
       Value& operator [](key_t const &key)
       { return get(key); }
       Value const& operator [](key_t const &key) const
       { return get(key); }
+      template <typename K, typename = detail::if_key_view<K>>
+      Value& operator [](K const &key)
+      { return get(key); }
+      template <typename K, typename = detail::if_key_view<K>>
+      Value const& operator [](K const &key) const
+      { return get(key); }
+      Value& operator [](hashed_key<key_t> const &key)
+      { return get(key); }
+      Value const& operator [](hashed_key<key_t> const &key) const
+      { return get(key); }
 
       bool empty() const
       { return values_.empty(); }
@@ -127,6 +230,43 @@ namespace jeayeson
         return it->second.template as<T>();
       }
 
+      /* Splits the path in place, rather than into strings. */
+      template <typename T = Value, typename K, typename = detail::if_key_view<K>>
+      T& get_for_path(K const &path) const
+      {
+        key_view const p{ path };
+        char const *begin{ p.data() };
+        char const * const end{ begin + p.size() };
+
+        map_t *sub_map(const_cast<map_t*>(this));
+        for(char const *dot; (dot = std::find(begin, end, '.')) != end; begin = dot + 1)
+        { sub_map = &sub_map->get<map_t>(key_view{ begin, static_cast<size_t>(dot - begin) }); }
+
+        return sub_map->get<T>(key_view{ begin, static_cast<size_t>(end - begin) });
+      }
+
+      template <typename T = Value, typename K, typename = detail::if_key_view<K>>
+      T get_for_path(K const &path, T &&fallback) const
+      {
+        key_view const p{ path };
+        char const *begin{ p.data() };
+        char const * const end{ begin + p.size() };
+
+        map_t const *sub_map(this);
+        for(char const *dot; ; begin = dot + 1)
+        {
+          dot = std::find(begin, end, '.');
+          auto const it
+          (sub_map->find(key_view{ begin, static_cast<size_t>(dot - begin) }));
+          if(it == sub_map->end())
+          { return std::forward<T>(fallback); }
+          if(dot == end)
+          { return it->second.template as<T>(); }
+
+          sub_map = &(it->second.template as<map_t>());
+        }
+      }
+
       std::vector<key_t> get_keys() const
       {
         std::vector<key_t> keys;
@@ -150,6 +290,18 @@ namespace jeayeson
       const_iterator find(key_t const &key) const
       { return values_.find(key); }
 
+      template <typename K, typename = detail::if_key_view<K>>
+      iterator find(K const &key)
+      { return detail::find_key(values_, key_view{ key }); }
+      template <typename K, typename = detail::if_key_view<K>>
+      const_iterator find(K const &key) const
+      { return detail::find_key(values_, key_view{ key }); }
+
+      iterator find(hashed_key<key_t> const &key)
+      { return detail::find_key(values_, key); }
+      const_iterator find(hashed_key<key_t> const &key) const
+      { return detail::find_key(values_, key); }
+
       bool has(key_t const &key)
       { return find(key) != end(); }
       bool has(key_t const &key) const
@@ -168,6 +320,44 @@ namespace jeayeson
         return it != end() && it->second.is(Value::template to_value<VT>::value);
       }
 
+      template <typename K, typename = detail::if_key_view<K>>
+      bool has(K const &key)
+      { return find(key) != end(); }
+      template <typename K, typename = detail::if_key_view<K>>
+      bool has(K const &key) const
+      { return find(key) != end(); }
+
+      template <typename VT, typename K, typename = detail::if_key_view<K>>
+      bool has(K const &key)
+      {
+        auto const it(find(key));
+        return it != end() && it->second.is(Value::template to_value<VT>::value);
+      }
+      template <typename VT, typename K, typename = detail::if_key_view<K>>
+      bool has(K const &key) const
+      {
+        auto const it(find(key));
+        return it != end() && it->second.is(Value::template to_value<VT>::value);
+      }
+
+      bool has(hashed_key<key_t> const &key)
+      { return find(key) != end(); }
+      bool has(hashed_key<key_t> const &key) const
+      { return find(key) != end(); }
+
+      template<typename VT>
+      bool has(hashed_key<key_t> const &key)
+      {
+        auto const it(find(key));
+        return it != end() && it->second.is(Value::template to_value<VT>::value);
+      }
+      template<typename VT>
+      bool has(hashed_key<key_t> const &key) const
+      {
+        auto const it(find(key));
+        return it != end() && it->second.is(Value::template to_value<VT>::value);
+      }
+
       iterator begin()
       { return values_.begin(); }
       const_iterator begin() const
@@ -196,6 +386,16 @@ namespace jeayeson
 
       void merge(map const &m)
       { values_.insert(m.values_.begin(), m.values_.end()); }
+      /* The values are moved across; only the keys are copied. */
+      void merge(map &&m)
+      {
+        values_.insert
+        (
+          std::make_move_iterator(m.values_.begin()),
+          std::make_move_iterator(m.values_.end())
+        );
+        m.clear();
+      }
 
       void reset(data const &json)
       { reset(json.data); }
@@ -203,6 +403,26 @@ namespace jeayeson
       { *this = Parser::template parse<map_t>(json); }
       void reset(file const &f)
       { *this = Parser::template parse<map_t>(f); }
+      void reset(span const &json)
+      { *this = Parser::template parse<map_t>(json); }
+      void reset(data const &json, validate const &v)
+      { *this = Parser::template parse<map_t>(json, v); }
+      void reset(span const &json, validate const &v)
+      { *this = Parser::template parse<map_t>(json, v); }
+      void reset(file const &f, validate const &v)
+      { *this = Parser::template parse<map_t>(f, v); }
+      void reset(data const &json, lazy const &l)
+      { *this = Parser::template parse<map_t>(json, l); }
+      void reset(span const &json, lazy const &l)
+      { *this = Parser::template parse<map_t>(json, l); }
+      void reset(file const &f, lazy const &l)
+      { *this = Parser::template parse<map_t>(f, l); }
+      void reset(data const &json, projection const &p)
+      { *this = Parser::template parse<map_t>(json, p); }
+      void reset(span const &json, projection const &p)
+      { *this = Parser::template parse<map_t>(json, p); }
+      void reset(file const &f, projection const &p)
+      { *this = Parser::template parse<map_t>(f, p); }
 
       std::string to_string() const
       { return Parser::template save<map_t>(*this); }
@@ -219,6 +439,13 @@ namespace jeayeson
       friend bool operator !=(map<V, P> const &lhs, map<V, P> const &rhs);
 
     private:
+      template <typename K>
+      static key_t make_key(K const &key)
+      {
+        key_view const k{ key };
+        return key_t(k.data(), k.size());
+      }
+
       mutable internal_map_t values_;
   };
 
@@ -0,0 +1,20 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: parallel.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace jeayeson
+{
+  /* Asks for an array's elements to be parsed across threads; zero
+   * threads means one per core. */
+  struct parallel
+  { std::size_t threads; };
+}
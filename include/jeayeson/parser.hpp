@@ -0,0 +1,101 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: parser.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "span.hpp"
+#include "data.hpp"
+#include "file.hpp"
+#include "detail/structural.hpp"
+#include "detail/parser_util.hpp"
+#include "detail/file_buffer.hpp"
+
+namespace jeayeson
+{
+  /* Parses one document after another, keeping its structural index,
+   * its stack and its string buffer from each to the next. Once those
+   * have grown to fit, the only allocations are for the nodes of the
+   * result.
+   *
+   *   json_parser p;
+   *   json_map msg;
+   *   while(next_message(buffer))
+   *   { p.parse(json_span{ buffer.data(), buffer.size() }, msg); }
+   */
+  template <typename Value, typename Parser>
+  class parser
+  {
+    public:
+      using map_t = map<Value, Parser>;
+      using array_t = array<Value, Parser>;
+      using value_type = Value;
+      using parser_t = Parser;
+
+      /* Replaces out with the first map, array or, for a value, any
+       * value at all, in the input. */
+      template <typename Container>
+      void parse(span const &json, Container &out)
+      {
+        out = Container{};
+        detail::index_structurals(json.data, json.size, index_);
+        for(std::size_t i{}; i < index_.size(); ++i)
+        {
+          if(starts(json.data[index_[i]], out))
+          {
+            detail::builder<Value, Parser> b{ out, stack_ };
+            Parser::parse(b, json.data, json.size, index_, i, str_);
+            b.finish();
+            return;
+          }
+        }
+      }
+      template <typename Container>
+      void parse(data const &json, Container &out)
+      { parse(span{ json.data.data(), json.data.size() }, out); }
+      template <typename Container>
+      void parse(file const &f, Container &out)
+      {
+        detail::file_buffer const buffer{ f.data };
+        parse(buffer.get(), out);
+      }
+
+      template <typename Container, typename Input>
+      Container parse(Input const &json)
+      {
+        Container out;
+        parse(json, out);
+        return out;
+      }
+
+      /* Gives back the scratch memory. */
+      void shrink()
+      {
+        detail::structural_index{}.swap(index_);
+        std::vector<frame_t>{}.swap(stack_);
+        std::string{}.swap(str_);
+      }
+
+    private:
+      using frame_t = detail::frame<Value, Parser>;
+
+      static bool starts(char const c, map_t const &)
+      { return c == map_t::delim_open; }
+      static bool starts(char const c, array_t const &)
+      { return c == array_t::delim_open; }
+      static bool starts(char const c, value_type const &)
+      { return detail::starts_value(c); }
+
+      detail::structural_index index_;
+      std::vector<frame_t> stack_;
+      std::string str_;
+  };
+}
@@ -0,0 +1,21 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: projection.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace jeayeson
+{
+  /* Asks for only these dotted paths, as given to get_for_path, to be
+   * parsed; everything else is skipped. */
+  struct projection
+  { std::vector<std::string> paths; };
+}
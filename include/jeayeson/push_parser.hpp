@@ -0,0 +1,312 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: push_parser.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+#include "span.hpp"
+#include "detail/parser_util.hpp"
+#include "detail/number.hpp"
+#include "detail/simd.hpp"
+
+namespace jeayeson
+{
+  /* Parses JSON which arrives in pieces, such as from a socket. Chunks
+   * may be split at any byte, including within a string, number or
+   * escape; only the token which straddles a split is buffered. Each
+   * top-level value is queued as soon as it's complete.
+   *
+   *   json_push_parser p;
+   *   p.feed(chunk);
+   *   while(p.ready())
+   *   { use(p.next()); }
+   */
+  template <typename Value, typename Parser>
+  class push_parser
+  {
+    public:
+      using map_t = map<Value, Parser>;
+      using array_t = array<Value, Parser>;
+      using value_type = Value;
+      using parser_t = Parser;
+
+      /* Containers nested deeper than this are rejected. */
+      static std::size_t constexpr const max_depth{ Parser::max_depth };
+
+      push_parser()
+      { stack_.emplace_back(root_); }
+      /* The stack points into root_, so it can't be copied. */
+      push_parser(push_parser const &) = delete;
+      push_parser& operator =(push_parser const &) = delete;
+
+      /* Consumes the chunk and returns how many top-level values it
+       * completed. */
+      std::size_t feed(span const &chunk)
+      {
+        std::size_t const before{ ready_.size() };
+        char const *it{ chunk.data };
+        char const * const end{ chunk.data + chunk.size };
+        while(it != end)
+        {
+          switch(token_)
+          {
+            case token_t::string:
+            { it = feed_string(it, end); } break;
+            case token_t::number:
+            case token_t::literal:
+            { it = feed_scalar(it, end); } break;
+            case token_t::none:
+            { it = feed_structural(it, end); } break;
+          }
+        }
+        return ready_.size() - before;
+      }
+      std::size_t feed(std::string const &chunk)
+      { return feed(span{ chunk.data(), chunk.size() }); }
+
+      /* Numbers and literals only end at the next delimiter; at the end
+       * of the input, there isn't one. */
+      std::size_t finish()
+      {
+        std::size_t const before{ ready_.size() };
+        if(token_ == token_t::number || token_ == token_t::literal)
+        { finish_scalar(); }
+        return ready_.size() - before;
+      }
+
+      bool ready() const
+      { return !ready_.empty(); }
+      std::size_t size() const
+      { return ready_.size(); }
+
+      /* The oldest complete top-level value. */
+      Value next()
+      {
+        Value val(std::move(ready_.front()));
+        ready_.pop_front();
+        return val;
+      }
+
+      /* Drops any partial value, along with those not yet taken. */
+      void reset()
+      {
+        ready_.clear();
+        root_.clear();
+        stack_.clear();
+        stack_.emplace_back(root_);
+        token_ = token_t::none;
+        token_buffer_.clear();
+        escaped_ = escape_next_ = false;
+      }
+
+    private:
+      enum class token_t{ none, string, number, literal };
+      using frame_t = detail::frame<Value, Parser>;
+
+      static bool is_delimiter(char const c)
+      {
+        switch(c)
+        {
+          case ',': case ':': case '[': case ']': case '{': case '}':
+          case '"': case ' ': case '\t': case '\n': case '\r':
+            return true;
+          default:
+            return false;
+        }
+      }
+
+      void push_frame(frame_t const &f)
+      {
+        if(stack_.size() > max_depth)
+        {
+          throw std::runtime_error
+          { "exceeded max parse depth: " + std::to_string(max_depth) };
+        }
+        stack_.push_back(f);
+      }
+
+      /* Anything left in the root, with nothing open, is complete. */
+      void flush()
+      {
+        if(stack_.size() != 1 || root_.empty())
+        { return; }
+        for(auto &val : root_)
+        { ready_.push_back(std::move(val)); }
+        root_.clear();
+      }
+
+      char const* feed_structural(char const *it, char const * const end)
+      {
+        for( ; it != end; ++it)
+        {
+          frame_t &top(stack_.back());
+          switch(*it)
+          {
+            case map_t::delim_open:
+            { push_frame(top.template push_back_child<map_t>()); } break;
+            case array_t::delim_open:
+            { push_frame(top.template push_back_child<array_t>()); } break;
+
+            case map_t::delim_close:
+            case array_t::delim_close:
+            {
+              if(stack_.size() > 1)
+              { stack_.pop_back(); }
+              flush();
+            } break;
+
+            case '"':
+            {
+              token_ = token_t::string;
+              token_buffer_.clear();
+              escaped_ = escape_next_ = false;
+              return it + 1;
+            }
+
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+            {
+              token_ = token_t::number;
+              token_buffer_.clear();
+              return it;
+            }
+
+            case 'n':
+            case 't':
+            case 'f':
+            {
+              token_ = token_t::literal;
+              token_buffer_.clear();
+              return it;
+            }
+
+            /* Separators or unimportant/unknown characters. */
+            default:
+              break;
+          }
+        }
+        return it;
+      }
+
+      /* The raw bytes of a string are kept, escapes and all, until its
+       * closing quote arrives; only then is it decoded. */
+      char const* feed_string(char const *it, char const * const end)
+      {
+        if(escape_next_)
+        {
+          token_buffer_ += *it++;
+          escape_next_ = false;
+        }
+
+        while(it != end)
+        {
+          char const * const run{ detail::simd::find_quote_or_escape(it, end) };
+          token_buffer_.append(it, run);
+          if(run == end)
+          { return end; }
+
+          it = run;
+          if(*it == '"')
+          {
+            finish_string();
+            return it + 1;
+          }
+
+          /* A backslash; whatever follows is taken verbatim, even if
+           * it's in the next chunk. */
+          escaped_ = true;
+          token_buffer_ += *it++;
+          if(it == end)
+          {
+            escape_next_ = true;
+            return end;
+          }
+          token_buffer_ += *it++;
+        }
+        return it;
+      }
+
+      char const* feed_scalar(char const *it, char const * const end)
+      {
+        char const *stop{ it };
+        for( ; stop != end && !is_delimiter(*stop); ++stop)
+        { }
+        token_buffer_.append(it, stop);
+        if(stop != end)
+        { finish_scalar(); }
+        return stop;
+      }
+
+      /* Without escapes, the raw bytes are already the string. */
+      void decode_string(std::string &out)
+      {
+        if(escaped_)
+        {
+          char const * const begin{ token_buffer_.data() };
+          detail::parse_string(begin, begin + token_buffer_.size(), out);
+        }
+        else
+        { out.swap(token_buffer_); }
+      }
+
+      void finish_string()
+      {
+        frame_t &top(stack_.back());
+        token_ = token_t::none;
+        if(top.state == detail::state_t::parse_value)
+        { decode_string(top.template push_back_child<std::string>()); }
+        else /* Parsing a key/name. */
+        {
+          decode_string(top.name);
+          top.state = detail::state_t::parse_value;
+        }
+        flush();
+      }
+
+      void finish_scalar()
+      {
+        frame_t &top(stack_.back());
+        char const * const begin{ token_buffer_.data() };
+        char const * const end{ begin + token_buffer_.size() };
+        if(token_ == token_t::number)
+        {
+          detail::number num;
+          detail::parse_number(begin, end, num);
+          if(num.is_real)
+          { top.push_back(num.real); }
+          else
+          { top.push_back(num.integer); }
+        }
+        else if(token_buffer_ == "null")
+        { top.push_back(Value{}); }
+        else if(token_buffer_ == "true")
+        { top.push_back(true); }
+        else
+        { top.push_back(false); }
+
+        token_ = token_t::none;
+        flush();
+      }
+
+      array_t root_;
+      std::vector<frame_t> stack_;
+      std::deque<Value> ready_;
+
+      token_t token_{ token_t::none };
+      std::string token_buffer_;
+      bool escaped_{};
+      bool escape_next_{};
+  };
+}
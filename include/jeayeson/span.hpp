@@ -0,0 +1,23 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: span.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace jeayeson
+{
+  /* JSON which is parsed where it sits, such as a network frame or
+   * shared memory. Only size bytes are read; no NUL is needed. */
+  struct span
+  {
+    char const *data;
+    std::size_t size;
+  };
+}
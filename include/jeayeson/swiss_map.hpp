@@ -0,0 +1,548 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: swiss_map.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <new>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <initializer_list>
+
+#include "hash.hpp"
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+namespace jeayeson
+{
+  /* A map backend, for config's map_t, suited to objects with
+   * thousands of keys. It's open-addressed: entries live in one array
+   * of slots, with a control byte for each slot holding either seven
+   * bits of the key's hash, or a mark for empty or deleted. Slots are
+   * probed in groups of 16, whose control bytes are matched all at
+   * once, so most lookups compare just the one key they're after.
+   * Inserting may move the entries, when the table grows; iteration
+   * order is arbitrary. Entries are std::pair<K, V>; changing a key
+   * through an iterator isn't allowed. */
+  template
+  <
+    typename K, typename V,
+    typename Alloc = std::allocator<std::pair<K, V>>,
+    typename Hash = fast_hash<K>
+  >
+  class swiss_map
+  {
+    public:
+      using key_type = K;
+      using mapped_type = V;
+      using value_type = std::pair<K, V>;
+      using size_type = std::size_t;
+      using allocator_type = Alloc;
+
+      template <bool Const>
+      class iterator_t
+      {
+        public:
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = typename swiss_map::value_type;
+          using difference_type = std::ptrdiff_t;
+          using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+          using reference = std::conditional_t<Const, value_type const&, value_type&>;
+
+          iterator_t() = default;
+          /* Mutable to const. */
+          template <bool C, typename = std::enable_if_t<Const && !C>>
+          iterator_t(iterator_t<C> const &it)
+            : ctrl_{ it.ctrl_ }
+            , slot_{ it.slot_ }
+            , end_{ it.end_ }
+          { }
+
+          reference operator *() const
+          { return *slot_; }
+          pointer operator ->() const
+          { return slot_; }
+
+          iterator_t& operator ++()
+          {
+            ++ctrl_;
+            ++slot_;
+            skip();
+            return *this;
+          }
+          iterator_t operator ++(int)
+          {
+            iterator_t const copy{ *this };
+            ++*this;
+            return copy;
+          }
+
+          friend bool operator ==(iterator_t const &lhs, iterator_t const &rhs)
+          { return lhs.slot_ == rhs.slot_; }
+          friend bool operator !=(iterator_t const &lhs, iterator_t const &rhs)
+          { return lhs.slot_ != rhs.slot_; }
+
+        private:
+          friend class swiss_map;
+          template <bool C>
+          friend class iterator_t;
+
+          iterator_t(unsigned char const * const ctrl, pointer const slot, unsigned char const * const end)
+            : ctrl_{ ctrl }
+            , slot_{ slot }
+            , end_{ end }
+          { skip(); }
+
+          /* On to the next full slot, or the end. */
+          void skip()
+          {
+            while(ctrl_ != end_ && *ctrl_ >= ctrl_empty)
+            {
+              ++ctrl_;
+              ++slot_;
+            }
+          }
+
+          unsigned char const *ctrl_{};
+          pointer slot_{};
+          unsigned char const *end_{};
+      };
+      using iterator = iterator_t<false>;
+      using const_iterator = iterator_t<true>;
+
+      swiss_map() = default;
+      swiss_map(std::initializer_list<std::pair<K const, V>> const list)
+      {
+        reserve(list.size());
+        insert(list.begin(), list.end());
+      }
+      swiss_map(swiss_map const &other)
+        : alloc_
+        {
+          std::allocator_traits<Alloc>::select_on_container_copy_construction
+          (other.alloc_)
+        }
+      {
+        reserve(other.size());
+        insert(other.begin(), other.end());
+      }
+      swiss_map(swiss_map &&other) noexcept
+        : alloc_{ std::move(other.alloc_) }
+      { steal(other); }
+      swiss_map& operator =(swiss_map const &other)
+      {
+        if(this != &other)
+        {
+          clear();
+          reserve(other.size());
+          insert(other.begin(), other.end());
+        }
+        return *this;
+      }
+      swiss_map& operator =(swiss_map &&other) noexcept
+      {
+        if(this != &other)
+        {
+          release();
+          alloc_ = std::move(other.alloc_);
+          steal(other);
+        }
+        return *this;
+      }
+      ~swiss_map()
+      { release(); }
+
+      iterator begin()
+      { return { ctrl_, slots_, ctrl_ + capacity_ }; }
+      const_iterator begin() const
+      { return { ctrl_, slots_, ctrl_ + capacity_ }; }
+      const_iterator cbegin() const
+      { return begin(); }
+      iterator end()
+      { return { ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_ }; }
+      const_iterator end() const
+      { return { ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_ }; }
+      const_iterator cend() const
+      { return end(); }
+
+      size_type size() const
+      { return size_; }
+      bool empty() const
+      { return !size_; }
+
+      iterator find(K const &key)
+      {
+        size_type const i{ position(key, hasher_(key)) };
+        return i == npos ? end() : at_slot(i);
+      }
+      const_iterator find(K const &key) const
+      {
+        size_type const i{ position(key, hasher_(key)) };
+        return i == npos ? end() : const_iterator{ ctrl_ + i, slots_ + i, ctrl_ + capacity_ };
+      }
+      size_type count(K const &key) const
+      { return find(key) != end(); }
+
+      /* With a transparent Hash, like fast_hash<std::string>, a key_view
+       * is found without making a K. */
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      iterator find(Q const &key)
+      {
+        size_type const i{ position(key, hasher_(key)) };
+        return i == npos ? end() : at_slot(i);
+      }
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      const_iterator find(Q const &key) const
+      {
+        size_type const i{ position(key, hasher_(key)) };
+        return i == npos ? end() : const_iterator{ ctrl_ + i, slots_ + i, ctrl_ + capacity_ };
+      }
+      template <typename Q, typename H = Hash, typename = detail::transparent_t<H, Q>>
+      size_type count(Q const &key) const
+      { return find(key) != end(); }
+
+      V& operator [](K const &key)
+      { return try_emplace(key).first->second; }
+      V& at(K const &key)
+      {
+        auto const it(find(key));
+        if(it == end())
+        { throw std::out_of_range{ "no such key" }; }
+        return it->second;
+      }
+
+      template <typename... Args>
+      std::pair<iterator, bool> try_emplace(K const &key, Args &&...args)
+      {
+        std::size_t const h{ hasher_(key) };
+        size_type const found{ position(key, h) };
+        if(found != npos)
+        { return { at_slot(found), false }; }
+
+        size_type const i{ claim(h) };
+        traits::construct
+        (
+          alloc_, slots_ + i, std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+        return { at_slot(i), true };
+      }
+      template <typename P>
+      std::pair<iterator, bool> emplace(P &&key, V value)
+      { return try_emplace(std::forward<P>(key), std::move(value)); }
+
+      /* Like std::map, an existing key keeps its value. */
+      template <typename P>
+      std::pair<iterator, bool> insert(P &&entry)
+      {
+        std::size_t const h{ hasher_(entry.first) };
+        size_type const found{ position(entry.first, h) };
+        if(found != npos)
+        { return { at_slot(found), false }; }
+
+        size_type const i{ claim(h) };
+        traits::construct(alloc_, slots_ + i, std::forward<P>(entry));
+        return { at_slot(i), true };
+      }
+      template <typename It>
+      void insert(It first, It const last)
+      {
+        for( ; first != last; ++first)
+        { insert(*first); }
+      }
+
+      size_type erase(K const &key)
+      {
+        size_type const i{ position(key, hasher_(key)) };
+        if(i == npos)
+        { return 0; }
+        erase_slot(i);
+        return 1;
+      }
+      iterator erase(const_iterator const it)
+      {
+        size_type const i{ static_cast<size_type>(it.slot_ - slots_) };
+        erase_slot(i);
+        return at_slot(i + 1);
+      }
+
+      void clear()
+      {
+        destroy_all();
+        if(capacity_)
+        { std::memset(ctrl_, ctrl_empty, capacity_); }
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+      }
+
+      /* Room for n entries without growing. */
+      void reserve(size_type const n)
+      {
+        if(!n)
+        { return; }
+        size_type slots{ capacity_ ? capacity_ : group_width };
+        while(max_load(slots) < n)
+        { slots *= 2; }
+        if(slots > capacity_)
+        { rehash(slots); }
+      }
+
+      void swap(swiss_map &other) noexcept
+      {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        swap(block_, other.block_);
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+      }
+
+      friend bool operator ==(swiss_map const &lhs, swiss_map const &rhs)
+      {
+        if(lhs.size() != rhs.size())
+        { return false; }
+        for(auto const &entry : lhs)
+        {
+          auto const it(rhs.find(entry.first));
+          if(it == rhs.end() || !(it->second == entry.second))
+          { return false; }
+        }
+        return true;
+      }
+      friend bool operator !=(swiss_map const &lhs, swiss_map const &rhs)
+      { return !(lhs == rhs); }
+
+    private:
+      using traits = std::allocator_traits<Alloc>;
+      using byte_alloc_t = typename traits::template rebind_alloc<unsigned char>;
+      using byte_traits = std::allocator_traits<byte_alloc_t>;
+
+      static size_type constexpr const npos{ static_cast<size_type>(-1) };
+      static size_type constexpr const group_width{ 16 };
+      static unsigned char constexpr const ctrl_empty{ 0x80 };
+      static unsigned char constexpr const ctrl_deleted{ 0xFE };
+
+      /* At most seven eighths full, counting deleted slots. */
+      static size_type max_load(size_type const slots)
+      { return slots - slots / 8; }
+
+      static unsigned char h2(std::size_t const h)
+      { return static_cast<unsigned char>(h & 0x7F); }
+
+      /* A bit per slot of the group at ctrl. */
+      static unsigned match(unsigned char const * const ctrl, unsigned char const b)
+      {
+#if defined(__SSE2__)
+        __m128i const group{ _mm_load_si128(reinterpret_cast<__m128i const*>(ctrl)) };
+        return static_cast<unsigned>
+        (_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(b)))));
+#else
+        unsigned bits{};
+        for(size_type i{}; i < group_width; ++i)
+        { bits |= unsigned{ ctrl[i] == b } << i; }
+        return bits;
+#endif
+      }
+      /* Empty and deleted are the only bytes with the top bit set. */
+      static unsigned match_free(unsigned char const * const ctrl)
+      {
+#if defined(__SSE2__)
+        return static_cast<unsigned>
+        (_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<__m128i const*>(ctrl))));
+#else
+        unsigned bits{};
+        for(size_type i{}; i < group_width; ++i)
+        { bits |= unsigned{ ctrl[i] >= ctrl_empty } << i; }
+        return bits;
+#endif
+      }
+
+      static size_type lowest(unsigned const bits)
+      {
+#ifdef __GNUC__
+        return static_cast<size_type>(__builtin_ctz(bits));
+#else
+        size_type n{};
+        for(unsigned b{ bits }; !(b & 1); b >>= 1)
+        { ++n; }
+        return n;
+#endif
+      }
+
+      iterator at_slot(size_type const i)
+      { return { ctrl_ + i, slots_ + i, ctrl_ + capacity_ }; }
+
+      /* Groups are probed in a triangular sequence, which visits every
+       * one of a power of two, until a group with an empty slot. */
+      template <typename Q>
+      size_type position(Q const &key, std::size_t const h) const
+      {
+        if(!capacity_)
+        { return npos; }
+        size_type const mask{ capacity_ / group_width - 1 };
+        unsigned char const tag{ h2(h) };
+        size_type g{ (h >> 7) & mask };
+        for(size_type step{ 1 }; ; ++step)
+        {
+          unsigned char const * const ctrl{ ctrl_ + g * group_width };
+          for(unsigned bits{ match(ctrl, tag) }; bits; bits &= bits - 1)
+          {
+            size_type const i{ g * group_width + lowest(bits) };
+            if(slots_[i].first == key)
+            { return i; }
+          }
+          if(match(ctrl, ctrl_empty) || step > mask)
+          { return npos; }
+          g = (g + step) & mask;
+        }
+      }
+
+      /* Marks a free slot for a new key, growing first if need be. */
+      size_type claim(std::size_t const h)
+      {
+        if(!growth_left_)
+        {
+          /* Mostly deleted slots are cleaned out in place. */
+          rehash(size_ * 2 < max_load(capacity_) ? capacity_ : capacity_ * 2);
+        }
+
+        size_type const mask{ capacity_ / group_width - 1 };
+        size_type g{ (h >> 7) & mask };
+        for(size_type step{ 1 }; ; ++step)
+        {
+          unsigned const bits{ match_free(ctrl_ + g * group_width) };
+          if(bits)
+          {
+            size_type const i{ g * group_width + lowest(bits) };
+            if(ctrl_[i] == ctrl_empty)
+            { --growth_left_; }
+            ctrl_[i] = h2(h);
+            ++size_;
+            return i;
+          }
+          g = (g + step) & mask;
+        }
+      }
+
+      /* A slot may go back to empty only if its group has never been
+       * full, since then no probe has gone past it. */
+      void erase_slot(size_type const i)
+      {
+        traits::destroy(alloc_, slots_ + i);
+        unsigned char * const group{ ctrl_ + i / group_width * group_width };
+        if(match(group, ctrl_empty))
+        {
+          ctrl_[i] = ctrl_empty;
+          ++growth_left_;
+        }
+        else
+        { ctrl_[i] = ctrl_deleted; }
+        --size_;
+      }
+
+      void rehash(size_type slots)
+      {
+        if(slots < group_width)
+        { slots = group_width; }
+
+        byte_alloc_t bytes{ alloc_ };
+        unsigned char * const ctrl{ byte_traits::allocate(bytes, slots + group_width) };
+        /* Aligned to a group, for the loads. */
+        unsigned char * const aligned
+        {
+          reinterpret_cast<unsigned char*>
+          ((reinterpret_cast<std::uintptr_t>(ctrl) + group_width - 1) & ~(group_width - 1))
+        };
+        value_type * const table{ traits::allocate(alloc_, slots) };
+        std::memset(aligned, ctrl_empty, slots);
+
+        unsigned char * const old_ctrl{ ctrl_ };
+        unsigned char * const old_block{ block_ };
+        value_type * const old_slots{ slots_ };
+        size_type const old_capacity{ capacity_ };
+
+        block_ = ctrl;
+        ctrl_ = aligned;
+        slots_ = table;
+        capacity_ = slots;
+        size_ = 0;
+        growth_left_ = max_load(slots);
+
+        for(size_type i{}; i < old_capacity; ++i)
+        {
+          if(old_ctrl[i] < ctrl_empty)
+          {
+            size_type const to{ claim(hasher_(old_slots[i].first)) };
+            traits::construct(alloc_, slots_ + to, std::move(old_slots[i]));
+            traits::destroy(alloc_, old_slots + i);
+          }
+        }
+        if(old_capacity)
+        {
+          traits::deallocate(alloc_, old_slots, old_capacity);
+          byte_traits::deallocate(bytes, old_block, old_capacity + group_width);
+        }
+      }
+
+      void destroy_all()
+      {
+        for(size_type i{}; i < capacity_; ++i)
+        {
+          if(ctrl_[i] < ctrl_empty)
+          { traits::destroy(alloc_, slots_ + i); }
+        }
+      }
+
+      void release()
+      {
+        if(!capacity_)
+        { return; }
+        destroy_all();
+        byte_alloc_t bytes{ alloc_ };
+        traits::deallocate(alloc_, slots_, capacity_);
+        byte_traits::deallocate(bytes, block_, capacity_ + group_width);
+        block_ = ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = size_ = growth_left_ = 0;
+      }
+
+      void steal(swiss_map &other) noexcept
+      {
+        block_ = other.block_;
+        ctrl_ = other.ctrl_;
+        slots_ = other.slots_;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+        other.block_ = other.ctrl_ = nullptr;
+        other.slots_ = nullptr;
+        other.capacity_ = other.size_ = other.growth_left_ = 0;
+      }
+
+      Alloc alloc_;
+      Hash hasher_;
+      unsigned char *block_{};
+      unsigned char *ctrl_{};
+      value_type *slots_{};
+      size_type capacity_{};
+      size_type size_{};
+      size_type growth_left_{};
+  };
+}
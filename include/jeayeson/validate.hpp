@@ -0,0 +1,18 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: validate.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+namespace jeayeson
+{
+  /* Asks for the input to be checked as UTF-8, in the same pass which
+   * finds its structure; invalid input throws. */
+  struct validate
+  { };
+}
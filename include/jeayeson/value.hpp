@@ -9,14 +9,23 @@
 
 #pragma once
 
-#include <boost/variant.hpp>
+#include <mutex>
+#include <atomic>
+#include <memory>
 
 #include "detail/normalize.hpp"
+#include "detail/variant.hpp"
 #include "file.hpp"
 #include "data.hpp"
+#include "span.hpp"
 #include "map.hpp"
 #include "array.hpp"
 #include "detail/parser.hpp"
+#include "parser.hpp"
+#include "push_parser.hpp"
+#include "handler.hpp"
+#include "cursor.hpp"
+#include "lines.hpp"
 #include "detail/escape.hpp"
 
 /* TODO: optional_cast. */
@@ -25,7 +34,7 @@ namespace jeayeson
   class value
   {
     public:
-      /* Maps to the variant 1:1. */
+      /* Maps to the variant 1:1, save for deferred maps and arrays. */
       enum class type
       {
         null,
@@ -47,7 +56,7 @@ namespace jeayeson
         { return false; }
       };
 
-      using variant_t = boost::variant
+      using variant_t = detail::variant
       <
         null_t,
         detail::int_t,
@@ -55,7 +64,8 @@ namespace jeayeson
         bool,
         std::string,
         map_t,
-        array_t
+        array_t,
+        detail::deferred
       >;
 
       template <type T>
@@ -66,8 +76,13 @@ namespace jeayeson
       value()
         : value_{ null_t{} }
       { }
-      value(value const &copy)
-        : value_{ copy.value_ }
+      value(value const &) = default;
+      value(value &&) noexcept = default;
+      value& operator =(value const &) = default;
+      value& operator =(value &&) noexcept = default;
+      /* A lazily parsed map or array; see json_lazy. */
+      value(detail::deferred &&d)
+        : value_{ std::move(d) }
       { }
 
       template
@@ -100,10 +115,10 @@ namespace jeayeson
 
       template <typename T>
       auto& get()
-      { return boost::get<detail::normalize<T>>(value_); }
+      { return detail::get<detail::normalize<T>>(resolved()); }
       template <typename T>
       auto const& get() const
-      { return boost::get<detail::normalize<T>>(value_); }
+      { return detail::get<detail::normalize<T>>(resolved()); }
 
       template <typename T>
       auto& as()
@@ -126,6 +141,21 @@ namespace jeayeson
         }
         return as<map_t>()[key];
       }
+      /* String literals and key_views, which don't make a key_t. */
+      template <typename K, typename = detail::if_key_view<K>>
+      value& operator [](K const &key)
+      {
+        if(get_type() != type::map)
+        {
+          throw std::runtime_error
+          {
+            "invalid value type (" +
+            std::to_string(value_.which()) +
+            "); required map"
+          };
+        }
+        return as<map_t>()[key];
+      }
       value& operator [](array_t::index_t const &index)
       {
         if(get_type() != type::array)
@@ -149,7 +179,11 @@ namespace jeayeson
 
       /* TODO: Rename to type() */
       type get_type() const
-      { return static_cast<type>(value_.which()); }
+      {
+        if(auto const * const d = detail::get_if<detail::deferred>(&value_))
+        { return d->is_map() ? type::map : type::array; }
+        return static_cast<type>(value_.which());
+      }
       bool is(type const t) const
       { return get_type() == t; }
 
@@ -166,41 +200,115 @@ namespace jeayeson
       friend bool operator !=(T const &val, value const &jv);
       friend std::ostream& operator <<(std::ostream &stream, value const &val);
 
-      /* We can avoid superfluous copying by checking whether or not to normalize. */
+      /* We can avoid superfluous copying by checking whether or not to normalize.
+       * Strings, maps and arrays which are passed as rvalues are moved in. */
       template <typename T>
-      std::enable_if_t<!detail::should_normalize<T>()> set(T const &val)
-      { value_ = val; }
+      std::enable_if_t<!detail::should_normalize<T>()> set(T &&val)
+      { value_ = std::forward<T>(val); }
       template <typename T>
-      std::enable_if_t<detail::should_normalize<T>()> set(T const &val)
-      { value_ = detail::normalize<T>(val); }
+      std::enable_if_t<detail::should_normalize<T>()> set(T &&val)
+      { value_ = detail::normalize<std::decay_t<T>>(val); }
 
       void set(std::nullptr_t)
       { value_ = null_t{}; }
 
       /* Shortcut add for arrays. */
       template <typename T>
-      void push_back(T const &val)
-      { as<array_t>().push_back(val); }
+      void push_back(T &&val)
+      { as<array_t>().push_back(std::forward<T>(val)); }
 
       /* Shortcut add for maps. */
       template <typename T>
-      void push_back(std::string const &key, T const &val)
-      { as<map_t>().set(key, val); }
+      void push_back(std::string const &key, T &&val)
+      { as<map_t>().set(key, std::forward<T>(val)); }
 
       template
       <
         typename T,
         typename E = std::enable_if_t<detail::is_convertible<T, value>()>
       >
-      variant_t& operator =(T const &val)
-      { set(val); return value_; }
+      variant_t& operator =(T &&val)
+      { set(std::forward<T>(val)); return value_; }
 
     private:
+      /* The variant, or the map or array a deferred one expands to. */
+      variant_t const& resolved() const;
+      variant_t& resolved()
+      {
+        return const_cast<variant_t&>
+        (static_cast<value const&>(*this).resolved());
+      }
+
       variant_t value_;
   };
 
+  namespace detail
+  {
+    /* A deferred map or array, parsed one level deep the first time
+     * it's touched. The flag makes that safe from several threads. */
+    struct expansion
+    {
+      std::once_flag once;
+      std::atomic<bool> done{};
+      value built;
+    };
+
+    inline deferred::deferred
+    (std::shared_ptr<document const> const &d, std::size_t const j)
+      : doc{ d }
+      , i{ j }
+      , expanded{ new expansion }
+    { }
+    /* A copy is only parsed again if the original hasn't been. */
+    inline deferred::deferred(deferred const &other)
+      : deferred{ other.doc, other.i }
+    {
+      if(other.expanded && other.expanded->done.load(std::memory_order_acquire))
+      {
+        expanded->built = other.expanded->built;
+        std::call_once(expanded->once, []{});
+        expanded->done.store(true, std::memory_order_release);
+      }
+    }
+    inline deferred::deferred(deferred &&) noexcept = default;
+    inline deferred& deferred::operator =(deferred const &other)
+    { return *this = deferred{ other }; }
+    inline deferred& deferred::operator =(deferred &&) noexcept = default;
+    inline deferred::~deferred() = default;
+  }
+
+  inline value::variant_t const& value::resolved() const
+  {
+    auto const * const d(detail::get_if<detail::deferred>(&value_));
+    if(!d)
+    { return value_; }
+
+    detail::expansion &e(*d->expanded);
+    std::call_once(e.once, [&]
+    {
+      if(d->is_map())
+      {
+        map_t m;
+        detail::expand(m, d->doc, d->i);
+        e.built.value_ = std::move(m);
+      }
+      else
+      {
+        array_t arr;
+        detail::expand(arr, d->doc, d->i);
+        e.built.value_ = std::move(arr);
+      }
+      e.done.store(true, std::memory_order_release);
+    });
+    return e.built.value_;
+  }
+
   using map_t = map<value, detail::parser>;
   using array_t = array<value, detail::parser>;
+  using parser_t = parser<value, detail::parser>;
+  using push_parser_t = push_parser<value, detail::parser>;
+  using cursor_t = cursor<value, detail::parser>;
+  using lines_t = lines<value, detail::parser>;
 
   template <>
   inline auto& value::get<value>()
@@ -227,11 +335,23 @@ using json_int = jeayeson::detail::int_t;
 using json_float = jeayeson::detail::float_t;
 using json_file = jeayeson::file;
 using json_data = jeayeson::data;
+using json_span = jeayeson::span;
+using json_key_view = jeayeson::key_view;
+using json_key = jeayeson::hashed_key<jeayeson::detail::key_t>;
+using json_parser = jeayeson::parser_t;
+using json_push_parser = jeayeson::push_parser_t;
+using json_handler = jeayeson::handler;
+using json_cursor = jeayeson::cursor_t;
+using json_lines = jeayeson::lines_t;
+using json_parallel = jeayeson::parallel;
+using json_lazy = jeayeson::lazy;
+using json_projection = jeayeson::projection;
+using json_validate = jeayeson::validate;
 
 namespace jeayeson
 {
   inline bool operator ==(json_value const &jv, json_value const &val)
-  { return jv.get_type() == val.get_type() && jv.value_ == val.value_; }
+  { return jv.get_type() == val.get_type() && jv.resolved() == val.resolved(); }
   template <typename T>
   bool operator ==(json_value const &jv, T const &val)
   { return jv.get_type() == value::to_value<T>::value && jv.as<T>() == val; }
@@ -248,3 +368,5 @@ namespace jeayeson
   bool operator !=(T const &val, json_value const &jv)
   { return !(jv == val); }
 }
+
+#include "bind.hpp"
@@ -0,0 +1,115 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/map/flat.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jest/jest.hpp>
+
+#include <string>
+#include <vector>
+#include <iterator>
+
+namespace jeayeson
+{
+  struct map_flat_test{};
+  using map_flat_group = jest::group<map_flat_test>;
+  static map_flat_group const map_flat_obj{ "map flat" };
+
+  using flat_t = flat_map<std::string, int>;
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::map_flat_group::test<0>() /* small */
+  {
+    jeayeson::flat_t m{ { "b", 2 }, { "a", 1 } };
+    m["c"] = 3;
+    expect_equal(m.size(), 3ul);
+    expect_equal(m["a"], 1);
+    expect(m.find("d") == m.end());
+    expect_equal(m.count("b"), 1ul);
+
+    /* In the order they were added. */
+    std::vector<std::string> keys;
+    for(auto const &entry : m)
+    { keys.push_back(entry.first); }
+    expect_equal(keys, std::vector<std::string>{ "b", "a", "c" });
+
+    /* An existing key keeps its value. */
+    expect(!m.insert(std::make_pair(std::string{ "a" }, 10)).second);
+    expect_equal(m["a"], 1);
+
+    expect_equal(m.erase("b"), 1ul);
+    expect_equal(m.erase("b"), 0ul);
+    expect_equal(m.size(), 2ul);
+    expect_equal(m.begin()->first, "a");
+    expect_equal(m["c"], 3);
+
+    m.clear();
+    expect(m.empty());
+    expect(m.find("a") == m.end());
+  }
+
+  template <> template <>
+  void jeayeson::map_flat_group::test<1>() /* large, with the index */
+  {
+    jeayeson::flat_t m;
+    for(int i{}; i < 1000; ++i)
+    { m["key_" + std::to_string(i)] = i; }
+    expect_equal(m.size(), 1000ul);
+    for(int i{}; i < 1000; ++i)
+    { expect_equal(m.find("key_" + std::to_string(i))->second, i); }
+    expect(m.find("key_1000") == m.end());
+
+    for(int i{}; i < 1000; i += 2)
+    { m.erase("key_" + std::to_string(i)); }
+    expect_equal(m.size(), 500ul);
+    for(int i{}; i < 1000; ++i)
+    { expect_equal(m.count("key_" + std::to_string(i)), i % 2 ? 1ul : 0ul); }
+
+    /* Back down to where it's scanned. */
+    for(int i{ 1 }; i < 1000 - 20; i += 2)
+    { m.erase("key_" + std::to_string(i)); }
+    expect_equal(m.size(), 10ul);
+    expect_equal(m["key_999"], 999);
+  }
+
+  template <> template <>
+  void jeayeson::map_flat_group::test<2>() /* integer keys */
+  {
+    /* std::hash is the identity for these. */
+    jeayeson::flat_map<int, int> m;
+    for(int i{}; i < 200; ++i)
+    { m[i * 64] = i; }
+    for(int i{}; i < 200; ++i)
+    { expect_equal(m[i * 64], i); }
+    expect_equal(m.size(), 200ul);
+  }
+
+  template <> template <>
+  void jeayeson::map_flat_group::test<3>() /* equality, swap and merge */
+  {
+    jeayeson::flat_t const a{ { "x", 1 }, { "y", 2 } };
+    jeayeson::flat_t b{ { "y", 2 }, { "x", 1 } };
+    expect(a == b);
+    b["x"] = 3;
+    expect(a != b);
+
+    jeayeson::flat_t c{ { "z", 26 } };
+    c.swap(b);
+    expect_equal(c.size(), 2ul);
+    expect_equal(b.size(), 1ul);
+    expect_equal(b["z"], 26);
+
+    c.insert(std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+    expect_equal(c.size(), 3ul);
+    expect_equal(c["z"], 26);
+  }
+}
@@ -0,0 +1,88 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/map/intern.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/interned_key.hpp>
+#include <jest/jest.hpp>
+
+#include <map>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+namespace jeayeson
+{
+  struct map_intern_test{};
+  using map_intern_group = jest::group<map_intern_test>;
+  static map_intern_group const map_intern_obj{ "map intern" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::map_intern_group::test<0>() /* one copy per key */
+  {
+    jeayeson::interned_key const a{ "timestamp" };
+    jeayeson::interned_key const b{ std::string{ "timestamp" } };
+    jeayeson::interned_key const c{ "time" };
+    expect(a == b);
+    expect(a != c);
+    expect_equal(&a.str(), &b.str());
+    expect_equal(a.str(), "timestamp");
+    expect_equal(c.size(), 4ul);
+    expect(jeayeson::interned_key{}.empty());
+
+    std::size_t const size{ jeayeson::key_pool::global().size() };
+    jeayeson::interned_key const again{ "timestamp" };
+    expect_equal(jeayeson::key_pool::global().size(), size);
+    jeayeson::interned_key const fresh{ "a key no other test uses" };
+    expect_equal(jeayeson::key_pool::global().size(), size + 1);
+  }
+
+  template <> template <>
+  void jeayeson::map_intern_group::test<1>() /* ordered by string */
+  {
+    std::map<jeayeson::interned_key, int> m;
+    m["zebra"] = 3;
+    m["apple"] = 1;
+    m["mango"] = 2;
+    m["apple"] = 4;
+    expect_equal(m.size(), 3ul);
+
+    std::vector<std::string> keys;
+    for(auto const &it : m)
+    { keys.push_back(it.first); }
+    expect_equal(keys, std::vector<std::string>{ "apple", "mango", "zebra" });
+    expect_equal(m["apple"], 4);
+
+    std::unordered_map<jeayeson::interned_key, int> u{ { "x", 1 }, { "y", 2 } };
+    expect_equal(u.at("y"), 2);
+    expect(u.find("z") == u.end());
+  }
+
+  template <> template <>
+  void jeayeson::map_intern_group::test<2>() /* threads */
+  {
+    std::vector<std::string const*> seen(8);
+    std::vector<std::thread> threads;
+    for(std::size_t t{}; t < seen.size(); ++t)
+    {
+      threads.emplace_back([&seen, t]
+      {
+        for(std::size_t i{}; i < 1000; ++i)
+        { jeayeson::interned_key const k{ "shared_" + std::to_string(i) }; }
+        seen[t] = &jeayeson::interned_key{ "shared_500" }.str();
+      });
+    }
+    for(auto &thread : threads)
+    { thread.join(); }
+    for(auto const s : seen)
+    { expect_equal(s, seen[0]); }
+  }
+}
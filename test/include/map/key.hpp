@@ -0,0 +1,106 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/map/key.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <jeayeson/interned_key.hpp>
+#include <jest/jest.hpp>
+
+#include "parser/allocations.hpp"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace jeayeson
+{
+  struct map_key_test{};
+  using map_key_group = jest::group<map_key_test>;
+  static map_key_group const map_key_obj{ "map key" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::map_key_group::test<0>() /* the same as with a key_t */
+  {
+    json_map map{ json_data{ R"raw({"timestamp":1500,"tags":["a"],"long_key_name_for_sso":2})raw" } };
+    json_key const timestamp{ "timestamp" };
+    json_key const tags{ "tags" };
+    json_key const missing{ "missing" };
+
+    expect_equal(timestamp.key(), "timestamp");
+    expect_equal(map.get<json_int>(timestamp), 1500);
+    expect_equal(map[timestamp], 1500);
+    expect(map.find(timestamp) == map.find("timestamp"));
+    expect(map.has(tags));
+    expect(map.has<json_array>(tags));
+    expect(!map.has<json_map>(tags));
+    expect(!map.has(missing));
+    expect_equal(map.get(missing, json_int{ 3 }), 3);
+
+    json_map const &cmap(map);
+    expect_equal(cmap.get<json_int>(json_key{ "long_key_name_for_sso" }), 2);
+
+    /* A missing key is added, as with a key_t. */
+    expect(map.get(missing).is(json_value::type::null));
+    expect(map.has(missing));
+  }
+
+  template <> template <>
+  void jeayeson::map_key_group::test<1>() /* lookups don't allocate */
+  {
+    json_map const map{ json_data{ R"raw({"a_rather_long_key_name":42})raw" } };
+    json_key const key{ "a_rather_long_key_name" };
+    json_key const missing{ "a_missing_but_long_key_name" };
+
+    std::size_t const before{ jeayeson::allocations };
+    json_int sum{};
+    for(int i{}; i < 10; ++i)
+    {
+      sum += map.get<json_int>(key);
+      sum += map.get(missing, json_int{ 1 });
+      sum += map.has(key);
+    }
+    expect_equal(jeayeson::allocations - before, 0ul);
+    expect_equal(sum, 440);
+  }
+
+  template <> template <>
+  void jeayeson::map_key_group::test<2>() /* backends */
+  {
+    using key = jeayeson::hashed_key<std::string>;
+    key const one{ "one" };
+    key const three{ "three" };
+
+    jeayeson::flat_map<std::string, int> flat{ { "one", 1 }, { "two", 2 } };
+    expect_equal(flat.find(one)->second, 1);
+    expect(flat.find(three) == flat.end());
+
+    jeayeson::swiss_map<std::string, int> swiss{ { "one", 1 }, { "two", 2 } };
+    expect_equal(swiss.find(one)->second, 1);
+    expect_equal(swiss.count(three), 0ul);
+
+    std::map<std::string, int, std::less<>> ordered{ { "one", 1 } };
+    expect_equal(jeayeson::detail::find_key(ordered, one)->second, 1);
+    expect(jeayeson::detail::find_key(ordered, three) == ordered.end());
+
+    std::unordered_map<std::string, int> unordered{ { "one", 1 } };
+    expect_equal(jeayeson::detail::find_key(unordered, one)->second, 1);
+
+    /* Interned keys compare by pointer, and hash it. */
+    using interned = jeayeson::hashed_key<jeayeson::interned_key>;
+    jeayeson::swiss_map<jeayeson::interned_key, int> swiss_interned{ { "key_one", 1 } };
+    expect_equal(swiss_interned.find(interned{ "key_one" })->second, 1);
+    expect(swiss_interned.find(interned{ "key_two" }) == swiss_interned.end());
+    jeayeson::flat_map<jeayeson::interned_key, int> flat_interned{ { "key_one", 1 } };
+    expect_equal(flat_interned.find(interned{ "key_one" })->second, 1);
+  }
+}
@@ -0,0 +1,148 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/map/swiss.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <jest/jest.hpp>
+
+#include <set>
+#include <string>
+#include <iterator>
+
+namespace jeayeson
+{
+  struct map_swiss_test{};
+  using map_swiss_group = jest::group<map_swiss_test>;
+  static map_swiss_group const map_swiss_obj{ "map swiss" };
+
+  using swiss_t = swiss_map<std::string, int>;
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::map_swiss_group::test<0>() /* small */
+  {
+    jeayeson::swiss_t m{ { "b", 2 }, { "a", 1 } };
+    m["c"] = 3;
+    expect_equal(m.size(), 3ul);
+    expect_equal(m["a"], 1);
+    expect(m.find("d") == m.end());
+    expect_equal(m.count("b"), 1ul);
+
+    std::set<std::string> keys;
+    for(auto const &entry : m)
+    { keys.insert(entry.first); }
+    expect_equal(keys, std::set<std::string>{ "a", "b", "c" });
+
+    /* An existing key keeps its value. */
+    expect(!m.insert(std::make_pair(std::string{ "a" }, 10)).second);
+    expect_equal(m["a"], 1);
+
+    expect_equal(m.erase("b"), 1ul);
+    expect_equal(m.erase("b"), 0ul);
+    expect_equal(m.size(), 2ul);
+    expect_equal(std::distance(m.begin(), m.end()), 2l);
+
+    m.clear();
+    expect(m.empty());
+    expect(m.begin() == m.end());
+    expect(m.find("a") == m.end());
+  }
+
+  template <> template <>
+  void jeayeson::map_swiss_group::test<1>() /* growing and erasing */
+  {
+    jeayeson::swiss_t m;
+    for(int i{}; i < 10000; ++i)
+    { m["key_" + std::to_string(i)] = i; }
+    expect_equal(m.size(), 10000ul);
+    for(int i{}; i < 10000; ++i)
+    { expect_equal(m.find("key_" + std::to_string(i))->second, i); }
+    expect(m.find("key_10000") == m.end());
+
+    for(int i{}; i < 10000; i += 2)
+    { m.erase("key_" + std::to_string(i)); }
+    expect_equal(m.size(), 5000ul);
+    for(int i{}; i < 10000; ++i)
+    { expect_equal(m.count("key_" + std::to_string(i)), i % 2 ? 1ul : 0ul); }
+
+    /* Churn, which leaves deleted slots to be cleaned out. */
+    for(int round{}; round < 20; ++round)
+    {
+      for(int i{}; i < 1000; ++i)
+      { m["churn_" + std::to_string(round * 1000 + i)] = i; }
+      for(int i{}; i < 1000; ++i)
+      { m.erase("churn_" + std::to_string(round * 1000 + i)); }
+    }
+    expect_equal(m.size(), 5000ul);
+    expect_equal(std::distance(m.begin(), m.end()), 5000l);
+    expect_equal(m["key_9999"], 9999);
+  }
+
+  template <> template <>
+  void jeayeson::map_swiss_group::test<2>() /* integer keys */
+  {
+    /* std::hash is the identity for these, but fast_hash mixes it. */
+    jeayeson::swiss_map<int, int> m;
+    for(int i{}; i < 2000; ++i)
+    { m[i * 1024] = i; }
+    for(int i{}; i < 2000; ++i)
+    { expect_equal(m[i * 1024], i); }
+    expect_equal(m.size(), 2000ul);
+
+    for(auto it(m.begin()); it != m.end(); )
+    {
+      if(it->second % 2)
+      { it = m.erase(it); }
+      else
+      { ++it; }
+    }
+    expect_equal(m.size(), 1000ul);
+    expect_equal(m.count(1024), 0ul);
+    expect_equal(m.count(2048), 1ul);
+  }
+
+  template <> template <>
+  void jeayeson::map_swiss_group::test<3>() /* copy, move, equality and swap */
+  {
+    jeayeson::swiss_t const a{ { "x", 1 }, { "y", 2 } };
+    jeayeson::swiss_t b{ a };
+    expect(a == b);
+    b["x"] = 3;
+    expect(a != b);
+
+    jeayeson::swiss_t c{ std::move(b) };
+    expect(b.empty());
+    expect_equal(c["x"], 3);
+    b = c;
+    expect(b == c);
+
+    jeayeson::swiss_t d{ { "z", 26 } };
+    d.swap(c);
+    expect_equal(d.size(), 2ul);
+    expect_equal(c.size(), 1ul);
+    expect_equal(c["z"], 26);
+
+    d.insert(std::make_move_iterator(c.begin()), std::make_move_iterator(c.end()));
+    expect_equal(d.size(), 3ul);
+    expect_equal(d["z"], 26);
+  }
+
+  template <> template <>
+  void jeayeson::map_swiss_group::test<4>() /* hashing */
+  {
+    jeayeson::fast_hash<std::string> const hash{};
+    expect_equal(hash("key"), hash(std::string{ "key" }));
+    expect(hash("key") != hash("kez"));
+    /* Past a word, and with a partial word at the end. */
+    expect(hash("a_long_key_name_0") != hash("a_long_key_name_1"));
+    expect(hash("") != hash(std::string(1, '\0')));
+  }
+}
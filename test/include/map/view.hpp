@@ -0,0 +1,113 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/map/view.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/flat_map.hpp>
+#include <jeayeson/swiss_map.hpp>
+#include <jeayeson/interned_key.hpp>
+#include <jest/jest.hpp>
+
+#include "parser/allocations.hpp"
+
+#include <string>
+
+namespace jeayeson
+{
+  struct map_view_test{};
+  using map_view_group = jest::group<map_view_test>;
+  static map_view_group const map_view_obj{ "map view" };
+
+  /* Keys too long for the small string optimization. */
+  char constexpr const * const view_json
+  {
+    R"raw({"a_rather_long_key_name":{"another_long_key_name":42},)raw"
+    R"raw("short":"s","list":[1,2]})raw"
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::map_view_group::test<0>() /* the same as with a key_t */
+  {
+    json_map const map{ json_data{ jeayeson::view_json } };
+    jeayeson::key_view const key{ "short" };
+
+    expect_equal(map.get<std::string>("short"), "s");
+    expect_equal(map.get<std::string>(key), "s");
+    expect_equal(map["short"], map[std::string{ "short" }]);
+    expect(map.find(key) == map.find(std::string{ "short" }));
+    expect(map.find("nope") == map.end());
+    expect(map.has("list"));
+    expect(map.has<json_array>("list"));
+    expect(!map.has<json_map>("list"));
+    expect(!map.has(jeayeson::key_view{ "shor" }));
+    expect_equal(map.get("nope", json_int{ 7 }), 7);
+    expect_equal(map.get_for_path<json_int>("a_rather_long_key_name.another_long_key_name"), 42);
+    expect_equal(map.get_for_path("a_rather_long_key_name.nope", json_int{ 3 }), 3);
+    expect_equal(map.get_for_path("nope.another_long_key_name", json_int{ 3 }), 3);
+
+    json_value value(map);
+    expect_equal(value["short"], "s");
+    char const * const name{ "short" };
+    expect_equal(value[name], "s");
+  }
+
+  template <> template <>
+  void jeayeson::map_view_group::test<1>() /* lookups don't allocate */
+  {
+    json_map const map{ json_data{ jeayeson::view_json } };
+    json_map const &nested(map.get<json_map>("a_rather_long_key_name"));
+
+    std::size_t const before{ jeayeson::allocations };
+    json_int sum{};
+    sum += nested.get<json_int>("another_long_key_name");
+    sum += map.get_for_path<json_int>("a_rather_long_key_name.another_long_key_name");
+    sum += map.get_for_path("a_rather_long_key_name.missing_long_key_name", json_int{ 1 });
+    sum += map.has("a_rather_long_key_name");
+    sum += map.find("a_missing_but_long_key_name") == map.end();
+    /* A config.hpp from before std::less<> still makes a key_t. */
+    if(jeayeson::detail::finds_in_place<json_map::internal_map_t>())
+    { expect_equal(jeayeson::allocations - before, 0ul); }
+    expect_equal(sum, 42 + 42 + 1 + 1 + 1);
+  }
+
+  template <> template <>
+  void jeayeson::map_view_group::test<2>() /* missing keys are added, as before */
+  {
+    json_map map;
+    expect(map.get("added").is(json_value::type::null));
+    expect(map.has("added"));
+    map["other"] = 5;
+    expect_equal(map.get<json_int>("other"), 5);
+    expect_equal(map.size(), 2ul);
+    expect_exception<boost::bad_get>([&]{ map.get<json_int>("absent"); });
+  }
+
+  template <> template <>
+  void jeayeson::map_view_group::test<3>() /* backends */
+  {
+    jeayeson::flat_map<std::string, int> flat{ { "one", 1 }, { "two", 2 } };
+    expect_equal(flat.find(jeayeson::key_view{ "two" })->second, 2);
+    expect(flat.find(jeayeson::key_view{ "three" }) == flat.end());
+
+    jeayeson::swiss_map<std::string, int> swiss{ { "one", 1 }, { "two", 2 } };
+    expect_equal(swiss.find(jeayeson::key_view{ "one" })->second, 1);
+    expect_equal(swiss.count(jeayeson::key_view{ "three" }), 0ul);
+
+    std::map<std::string, int, std::less<>> ordered{ { "one", 1 } };
+    expect_equal(ordered.find(jeayeson::key_view{ "one" })->second, 1);
+
+    /* A string that's never been interned can't be in any map. */
+    jeayeson::swiss_map<jeayeson::interned_key, int> interned{ { "view_key", 1 } };
+    expect_equal(jeayeson::detail::find_key(interned, "view_key")->second, 1);
+    expect(!jeayeson::interned_key::existing("never_interned_view_key"));
+    expect(jeayeson::detail::find_key(interned, "never_interned_view_key") == interned.end());
+  }
+}
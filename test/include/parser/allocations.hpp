@@ -0,0 +1,34 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/allocations.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+namespace jeayeson
+{
+  /* Every allocation in the test binary is counted. */
+  static std::atomic<std::size_t> allocations{};
+}
+
+/* Not inlined, so the compiler doesn't pair malloc and free with
+ * new and delete at the call sites. */
+__attribute__((noinline)) void* operator new(std::size_t const size)
+{
+  ++jeayeson::allocations;
+  if(void * const p = std::malloc(size ? size : 1))
+  { return p; }
+  throw std::bad_alloc{};
+}
+__attribute__((noinline)) void operator delete(void * const p) noexcept
+{ std::free(p); }
+__attribute__((noinline)) void operator delete(void * const p, std::size_t) noexcept
+{ std::free(p); }
@@ -0,0 +1,130 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/arena.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/arena.hpp>
+#include <jest/jest.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "allocations.hpp"
+
+namespace jeayeson
+{
+  struct arena_test{};
+  using arena_group = jest::group<arena_test>;
+  static arena_group const arena_obj{ "arena" };
+
+  template <typename T>
+  using arena_vector = std::vector<T, arena_allocator<T>>;
+  using arena_map = std::map
+  <
+    int, double, std::less<int>,
+    arena_allocator<std::pair<int const, double>>
+  >;
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::arena_group::test<0>() /* nodes come from blocks */
+  {
+    jeayeson::arena a;
+    {
+      jeayeson::arena::scope const s{ a };
+      std::size_t const before{ jeayeson::allocations };
+      jeayeson::arena_map m;
+      for(int i{}; i < 100; ++i)
+      { m[i] = i * 0.5; }
+      expect_equal(jeayeson::allocations - before, 1ul);
+      expect_equal(m.size(), 100ul);
+      expect_equal(m[42], 21.0);
+
+      /* Freeing doesn't touch the heap, either. */
+      std::size_t const erase_before{ jeayeson::allocations };
+      m.clear();
+      expect_equal(jeayeson::allocations - erase_before, 0ul);
+    }
+    expect(a.reserved() >= 64 * 1024ul);
+    a.release();
+    expect_equal(a.reserved(), 0ul);
+  }
+
+  template <> template <>
+  void jeayeson::arena_group::test<1>() /* no scope uses the heap */
+  {
+    std::size_t const before{ jeayeson::allocations };
+    jeayeson::arena_map m;
+    for(int i{}; i < 100; ++i)
+    { m[i] = i; }
+    expect_equal(jeayeson::allocations - before, 100ul);
+  }
+
+  template <> template <>
+  void jeayeson::arena_group::test<2>() /* scopes nest */
+  {
+    jeayeson::arena outer, inner;
+    jeayeson::arena::scope const o{ outer };
+    {
+      jeayeson::arena::scope const i{ inner };
+      expect_equal(jeayeson::arena::current(), &inner);
+      jeayeson::arena_vector<int> v(10);
+      static_cast<void>(v);
+      expect(inner.reserved() > 0);
+    }
+    expect_equal(jeayeson::arena::current(), &outer);
+    expect_equal(outer.reserved(), 0ul);
+  }
+
+  template <> template <>
+  void jeayeson::arena_group::test<3>() /* moves keep the arena */
+  {
+    jeayeson::arena a;
+    jeayeson::arena_vector<int> built;
+    {
+      jeayeson::arena::scope const s{ a };
+      jeayeson::arena_vector<int> v(1000, 7);
+      built = std::move(v);
+    }
+    /* Built in the arena, then moved out of the scope. */
+    expect(built.get_allocator() != jeayeson::arena_allocator<int>{});
+    expect_equal(built[999], 7);
+
+    /* A copy made outside the scope is on the heap. */
+    std::size_t const before{ jeayeson::allocations };
+    jeayeson::arena_vector<int> const copy{ built };
+    expect_equal(jeayeson::allocations - before, 1ul);
+    expect(copy.get_allocator() == jeayeson::arena_allocator<int>{});
+    expect(copy == built);
+  }
+
+  template <> template <>
+  void jeayeson::arena_group::test<4>() /* alignment and big requests */
+  {
+    jeayeson::arena a{ 256 };
+    void * const c{ a.allocate(1, 1) };
+    void * const d{ a.allocate(sizeof(double), alignof(double)) };
+    expect(c != d);
+    expect_equal(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0ul);
+
+    /* Bigger than a block, so it gets its own; the current block is
+     * still used after. */
+    std::size_t const reserved{ a.reserved() };
+    void * const big{ a.allocate(4096, 16) };
+    expect_equal(reinterpret_cast<std::uintptr_t>(big) % 16, 0ul);
+    expect(a.reserved() >= reserved + 4096);
+    std::size_t const after_big{ a.reserved() };
+    a.allocate(8, 8);
+    expect_equal(a.reserved(), after_big);
+  }
+}
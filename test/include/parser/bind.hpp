@@ -0,0 +1,160 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/bind.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct bind_test{};
+  using bind_group = jest::group<bind_test>;
+  static bind_group const bind_obj{ "bind" };
+
+  struct bind_point
+  {
+    int x{}, y{};
+  };
+  struct bind_shape
+  {
+    std::string name;
+    double scale{ 1.0 };
+    bool closed{};
+    std::vector<bind_point> points;
+    boost::optional<std::string> note;
+    std::map<std::string, json_int> counts;
+    json_value extra;
+  };
+
+  template <>
+  struct bind<bind_point>
+  {
+    static auto fields()
+    { return std::make_tuple(field("x", &bind_point::x), field("y", &bind_point::y)); }
+  };
+  template <>
+  struct bind<bind_shape>
+  {
+    static auto fields()
+    {
+      return std::make_tuple
+      (
+        field("name", &bind_shape::name),
+        field("scale", &bind_shape::scale),
+        field("closed", &bind_shape::closed),
+        field("points", &bind_shape::points),
+        field("note", &bind_shape::note),
+        field("counts", &bind_shape::counts),
+        field("extra", &bind_shape::extra)
+      );
+    }
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::bind_group::test<0>() /* read */
+  {
+    auto const shape(jeayeson::read<jeayeson::bind_shape>(json_data
+    {
+      R"raw({ "name": "tri\"angle", "closed": true, "scale": 2,)raw"
+      R"raw( "ignored": { "a": [ 1, { "b": "}" } ] },)raw"
+      R"raw( "points": [ { "x": 1, "y": 2 }, { "y": -3, "x": 0 } ],)raw"
+      R"raw( "note": null, "counts": { "a": 1, "b": 2 }, "extra": [ 1, "two" ] })raw"
+    }));
+    expect_equal(shape.name, "tri\"angle");
+    expect_almost_equal(shape.scale, 2.0);
+    expect(shape.closed);
+    expect_equal(shape.points.size(), 2ul);
+    expect_equal(shape.points[1].x, 0);
+    expect_equal(shape.points[1].y, -3);
+    expect(!shape.note);
+    expect_equal(shape.counts.at("b"), 2);
+    expect_equal(shape.extra.as<json_array>(), json_array{ json_data{ R"raw([1,"two"])raw" } });
+  }
+
+  template <> template <>
+  void jeayeson::bind_group::test<1>() /* round trip */
+  {
+    jeayeson::bind_shape shape;
+    shape.name = "line\n";
+    shape.points = { { 1, 2 }, { 3, 4 } };
+    shape.note = std::string{ "note" };
+    shape.counts["z"] = 9;
+    shape.extra = json_map{ { "k", true } };
+    /* No short decimal form. */
+    shape.scale = 0.1 + 0.2;
+
+    std::string const json{ jeayeson::write(shape) };
+    expect_equal(json_map{ json_data{ json } }.get<std::string>("name"), "line\n");
+
+    auto const back(jeayeson::read<jeayeson::bind_shape>(json_span{ json.data(), json.size() }));
+    expect_equal(jeayeson::write(back), json);
+    expect_equal(*back.note, "note");
+    expect_equal(back.points[1].y, 4);
+    expect(back.scale == shape.scale);
+
+    shape.scale = std::numeric_limits<double>::quiet_NaN();
+    expect_exception<std::runtime_error>([&]{ jeayeson::write(shape); });
+    shape.scale = std::numeric_limits<double>::infinity();
+    expect_exception<std::runtime_error>([&]{ jeayeson::write(shape); });
+  }
+
+  template <> template <>
+  void jeayeson::bind_group::test<2>() /* top-level containers and missing fields */
+  {
+    auto const points(jeayeson::read<std::vector<jeayeson::bind_point>>(json_data{ R"raw([{"x":5},{}])raw" }));
+    expect_equal(points.size(), 2ul);
+    expect_equal(points[0].x, 5);
+    expect_equal(points[0].y, 0);
+    expect_equal(jeayeson::write(points), R"raw([{"x":5,"y":0},{"x":0,"y":0}])raw");
+
+    /* Existing storage is reused. */
+    std::vector<json_int> ints;
+    jeayeson::read(json_data{ "[1,2,3]" }, ints);
+    expect_equal(ints, (std::vector<json_int>{ 1, 2, 3 }));
+  }
+
+  template <> template <>
+  void jeayeson::bind_group::test<3>() /* wrong types */
+  {
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_point>(json_data{ R"raw({"x":"1"})raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_point>(json_data{ R"raw({"x":1.5})raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_shape>(json_data{ R"raw({"points":{}})raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_shape>(json_data{ R"raw({"points":[)raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_shape>(json_data{ R"raw({"extra":}"x":1})raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<jeayeson::bind_shape>(json_data{ R"raw({"extra":]"x":1})raw" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<json_value>(json_data{ R"raw(}"x":1)raw" }); });
+  }
+
+  template <> template <>
+  void jeayeson::bind_group::test<4>() /* integers out of range */
+  {
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<std::int8_t>(json_data{ "300" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<std::int8_t>(json_data{ "-129" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<unsigned>(json_data{ "-1" }); });
+    expect_exception<std::runtime_error>
+    ([]{ jeayeson::read<std::uint16_t>(json_data{ "65536" }); });
+
+    expect_equal(jeayeson::read<std::int8_t>(json_data{ "-128" }), -128);
+    expect_equal(jeayeson::read<std::uint8_t>(json_data{ "255" }), 255);
+    expect_equal(jeayeson::read<std::uint64_t>(json_data{ "9223372036854775807" }),
+                 9223372036854775807ull);
+  }
+}
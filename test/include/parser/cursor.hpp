@@ -0,0 +1,97 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/cursor.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct cursor_test{};
+  using cursor_group = jest::group<cursor_test>;
+  static cursor_group const cursor_obj{ "cursor" };
+
+  std::string const cursor_json
+  {
+    R"raw({"skip":{"a":[1,{"b":"}]"}],"c":"[{"},)raw"
+    R"raw("user":{"id":42,"name":"Tom\n","score":1.5,"admin":false,)raw"
+    R"raw("tags":["x","y\"",[]],"none":null},"k\"ey":7})raw"
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::cursor_group::test<0>() /* scalars */
+  {
+    json_cursor const doc{ json_data{ jeayeson::cursor_json } };
+    expect_equal(doc["user"]["id"].get<json_int>(), 42);
+    expect_equal(doc["user"]["name"].get<std::string>(), "Tom\n");
+    expect_almost_equal(doc["user"]["score"].get<json_float>(), 1.5);
+    expect_equal(doc["user"]["admin"].get<bool>(), false);
+    expect(doc["user"]["none"].is(json_value::type::null));
+    expect_equal(doc["k\"ey"].get<int>(), 7);
+    expect_equal(doc["user"].get<json_int>("id"), 42);
+    expect_equal(doc["user"]["tags"][1].get<std::string>(), "y\"");
+  }
+
+  template <> template <>
+  void jeayeson::cursor_group::test<1>() /* paths and fallbacks */
+  {
+    json_cursor const doc{ json_data{ jeayeson::cursor_json } };
+    expect_equal(doc.get_for_path<json_int>("user.id"), 42);
+    expect_equal(doc.get_for_path<json_int>("user.nope", 5), 5);
+    expect_equal(doc.get_for_path<json_int>("nope.id", 6), 6);
+    expect_equal(doc["user"].get<std::string>("nope", "x"), "x");
+    expect(doc.has("skip"));
+    expect(!doc.has("a"));
+    expect(!doc["skip"].has("b"));
+    expect_exception<std::runtime_error>([&]{ doc["nope"]; });
+    expect_exception<std::runtime_error>([&]{ doc["user"]["tags"][3]; });
+    expect_exception<std::runtime_error>([&]{ doc["user"]["id"].get<std::string>(); });
+  }
+
+  template <> template <>
+  void jeayeson::cursor_group::test<2>() /* sizes and subtrees */
+  {
+    json_cursor const doc{ json_data{ jeayeson::cursor_json } };
+    expect_equal(doc.size(), 3ul);
+    expect_equal(doc["user"].size(), 6ul);
+    expect_equal(doc["user"]["tags"].size(), 3ul);
+    expect(doc["user"]["tags"][2].empty());
+    expect_equal(doc["skip"]["a"][1]["b"].get<std::string>(), "}]");
+
+    json_map const full{ jeayeson::cursor_json };
+    expect_equal(doc.get<json_map>(), full);
+    expect_equal(doc["user"].get<json_map>(), full.get<json_map>("user"));
+    expect_equal(doc["skip"]["a"].get(), full.get_for_path("skip.a"));
+  }
+
+  template <> template <>
+  void jeayeson::cursor_group::test<3>() /* arrays and spans */
+  {
+    std::string const json{ R"raw([{"id":1},{"id":2},{"id":3}] trailing)raw" };
+    json_cursor const doc{ json_span{ json.data(), json.size() } };
+    expect_equal(doc.size(), 3ul);
+    expect_equal(doc[2]["id"].get<json_int>(), 3);
+    expect_equal(doc[0].get<json_map>(), json_map{ R"raw({"id":1})raw" });
+  }
+
+  template <> template <>
+  void jeayeson::cursor_group::test<4>() /* duplicate keys */
+  {
+    std::string const json{ R"raw({"k":1,"j":{"k":0},"k":2,"\u006b":3})raw" };
+    json_cursor const doc{ json_data{ json } };
+    json_map const full{ json };
+    expect_equal(doc["k"].get<json_int>(), 3);
+    expect_equal(doc["k"].get(), full["k"]);
+    expect_equal(doc.size(), 2ul);
+    expect_equal(doc.size(), full.size());
+    expect_equal(doc.get<json_map>(), full);
+  }
+}
@@ -0,0 +1,89 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/depth.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct depth_test{};
+  using depth_group = jest::group<depth_test>;
+  static depth_group const depth_obj{ "depth" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::depth_group::test<0>() /* deep nesting */
+  {
+    std::size_t const depth{ json_map::parser_t::max_depth };
+    std::string json;
+    for(std::size_t i{}; i < depth - 1; ++i)
+    { json += i % 2 ? "[" : R"raw({"a":)raw"; }
+    json += "42";
+    for(std::size_t i{ depth - 1 }; i > 0; --i)
+    { json += (i - 1) % 2 ? "]" : "}"; }
+
+    json_array const arr{ json_data{ "[" + json + "]" } };
+    json_value const *val{ &arr[0] };
+    for(std::size_t i{}; i < depth - 1; ++i)
+    {
+      if(i % 2)
+      { val = &val->as<json_array>()[0]; }
+      else
+      { val = &val->as<json_map>()["a"]; }
+    }
+    expect_equal(*val, 42);
+  }
+
+  template <> template <>
+  void jeayeson::depth_group::test<1>() /* too deep */
+  {
+    std::size_t const depth{ json_map::parser_t::max_depth };
+    std::string const json(depth + 1, '[');
+    expect_exception<std::runtime_error>
+    ([&]{ json_array{ json_data{ json } }; });
+  }
+
+  template <> template <>
+  void jeayeson::depth_group::test<2>() /* siblings */
+  {
+    json_map const map
+    { R"raw({"a":{"b":[1,{"c":2}],"d":{}},"e":[[],[3]],"f":4})raw" };
+    expect_equal(map.get_for_path<json_array>("a.b")[0], 1);
+    expect_equal
+    (map.get_for_path<json_array>("a.b")[1].as<json_map>()["c"], 2);
+    expect(map.get_for_path<json_map>("a.d").empty());
+    expect(map.get<json_array>("e")[0].as<json_array>().empty());
+    expect_equal(map.get<json_array>("e")[1].as<json_array>()[0], 3);
+    expect_equal(map["f"], 4);
+  }
+
+  template <> template <>
+  void jeayeson::depth_group::test<3>() /* stray close */
+  {
+    namespace detail = jeayeson::detail;
+    using builder_t = detail::builder<json_value, detail::parser>;
+    for(std::string const json : { R"raw(}"x":1)raw", R"raw(]"x":1)raw" })
+    {
+      detail::structural_index index;
+      detail::index_structurals(json.data(), json.size(), index);
+
+      json_value val;
+      builder_t slot{ val };
+      expect_exception<std::runtime_error>([&]
+      { detail::parser::parse(slot, json.data(), json.size(), index, 0); });
+
+      json_map map;
+      builder_t root{ map };
+      expect_exception<std::runtime_error>([&]
+      { detail::parser::parse(root, json.data(), json.size(), index, 0); });
+    }
+  }
+}
@@ -0,0 +1,67 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/file.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include <cstdio>
+
+namespace jeayeson
+{
+  struct file_test{};
+  using file_group = jest::group<file_test>;
+  static file_group const file_obj{ "file" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::file_group::test<0>() /* mapped and buffered */
+  {
+    using jeayeson::detail::file_buffer;
+    file_buffer const mapped{ "test/json/map.json" };
+    file_buffer const buffered
+    { "test/json/map.json", file_buffer::mode_t::buffered };
+    expect(!buffered.is_mapped());
+    expect_equal(mapped.get().size, buffered.get().size);
+    expect(std::equal
+    (
+      mapped.get().data, mapped.get().data + mapped.get().size,
+      buffered.get().data
+    ));
+    expect_equal
+    (
+      json_map{ json_file{ "test/json/map.json" } },
+      jeayeson::detail::parser::parse<json_map>(buffered.get())
+    );
+  }
+
+  template <> template <>
+  void jeayeson::file_group::test<1>() /* empty */
+  {
+    char const * const path{ "test/json/.empty.json" };
+    std::fclose(std::fopen(path, "w"));
+    json_map const map{ json_file{ path } };
+    std::remove(path);
+    expect(map.empty());
+  }
+
+  template <> template <>
+  void jeayeson::file_group::test<2>() /* non-existent */
+  {
+    expect_exception<std::runtime_error>
+    ([]{ json_map{ json_file{ "test/json/non-existent.json" } }; });
+    expect_exception<std::runtime_error>
+    ([]
+    {
+      jeayeson::detail::file_buffer
+      { "test/json/non-existent.json", jeayeson::detail::file_buffer::mode_t::buffered };
+    });
+  }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/handler.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct handler_test{};
+  using handler_group = jest::group<handler_test>;
+  static handler_group const handler_obj{ "handler" };
+
+  /* Writes each event down, in order. */
+  struct recorder : json_handler
+  {
+    void start_map(){ events += "{"; }
+    void end_map(){ events += "}"; }
+    void start_array(){ events += "["; }
+    void end_array(){ events += "]"; }
+    void key(std::string &k){ events += "k:" + k + " "; }
+    void string(std::string &s){ events += "s:" + s + " "; }
+    void integer(json_int const i){ events += "i:" + std::to_string(i) + " "; }
+    void real(json_float const f){ events += "r:" + std::to_string(f) + " "; }
+    void boolean(bool const b){ events += b ? "true " : "false "; }
+    void null(){ events += "null "; }
+
+    std::string events;
+  };
+
+  /* Only cares about one key. */
+  struct summer : json_handler
+  {
+    void key(std::string &k){ is_price = (k == "price"); }
+    void integer(json_int const i){ if(is_price) { total += i; } }
+
+    bool is_price{};
+    json_int total{};
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::handler_group::test<0>() /* events */
+  {
+    jeayeson::recorder r;
+    expect(jeayeson::parse
+    (
+      json_data{ R"raw(  {"a":[1,2.5,"x\n"],"b":{"c":null},"d":true,"e":false})raw" },
+      r
+    ));
+    expect_equal
+    (
+      r.events,
+      "{k:a [i:1 r:2.500000 s:x\n ]k:b {k:c null }k:d true k:e false }"
+    );
+
+    jeayeson::recorder arr;
+    expect(jeayeson::parse(json_data{ R"raw([{}, [], "k"])raw" }, arr));
+    expect_equal(arr.events, "[{}[]s:k ]");
+
+    jeayeson::recorder none;
+    expect(!jeayeson::parse(json_data{ "  42 " }, none));
+    expect(none.events.empty());
+  }
+
+  template <> template <>
+  void jeayeson::handler_group::test<1>() /* partial handler */
+  {
+    jeayeson::summer s;
+    jeayeson::parse
+    (
+      json_data
+      {
+        R"raw([{"price":3,"qty":10},{"name":"x","price":4},{"price":5}])raw"
+      },
+      s
+    );
+    expect_equal(s.total, 12);
+  }
+
+  template <> template <>
+  void jeayeson::handler_group::test<2>() /* too deep */
+  {
+    json_handler h;
+    std::string const json(json_map::parser_t::max_depth + 1, '[');
+    expect_exception<std::runtime_error>
+    ([&]{ jeayeson::parse(json_data{ json }, h); });
+  }
+}
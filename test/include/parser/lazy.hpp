@@ -0,0 +1,138 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/lazy.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <sstream>
+
+namespace jeayeson
+{
+  struct lazy_test{};
+  using lazy_group = jest::group<lazy_test>;
+  static lazy_group const lazy_obj{ "lazy" };
+
+  static std::string const lazy_json
+  {
+    R"raw({ "name": "cfg", "n": 2.5, "on": true, "none": null,)raw"
+    R"raw( "servers": [ { "host": "a\"b", "ports": [ 80, 443 ] }, [], {} ],)raw"
+    R"raw( "limits": { "cpu": 4, "deep": { "deeper": [ "x" ] } } })raw"
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::lazy_group::test<0>() /* same as eager */
+  {
+    json_map const eager{ json_data{ jeayeson::lazy_json } };
+    json_map const lazy{ json_data{ jeayeson::lazy_json }, json_lazy{} };
+    expect_equal(lazy, eager);
+    expect_equal(eager, lazy);
+    expect_equal(json_value{ lazy }, json_value{ eager });
+
+    std::ostringstream eager_out, lazy_out;
+    eager_out << eager;
+    lazy_out << lazy;
+    expect_equal(lazy_out.str(), eager_out.str());
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<1>() /* nested access */
+  {
+    json_map lazy{ json_data{ jeayeson::lazy_json }, json_lazy{} };
+    expect_equal(lazy.get<std::string>("name"), "cfg");
+    expect(lazy["servers"].is(json_value::type::array));
+    expect(lazy["limits"].is(json_value::type::map));
+    expect_equal(lazy["servers"][0]["host"], "a\"b");
+    expect_equal(lazy["servers"][0]["ports"][1], 443);
+    expect_equal(lazy.get_for_path<json_int>("limits.cpu"), 4);
+    expect_equal
+    (lazy.get_for_path<json_array>("limits.deep.deeper")[0], "x");
+
+    /* Materialized values are ordinary values. */
+    lazy["limits"]["cpu"] = 8;
+    expect_equal(lazy.get_for_path<json_int>("limits.cpu"), 8);
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<2>() /* copies outlive the source */
+  {
+    json_value copy;
+    {
+      std::string const json{ R"raw([ [ 1, { "a": [ 2 ] } ], "s" ])raw" };
+      json_array const lazy{ json_span{ json.data(), json.size() }, json_lazy{} };
+      copy = lazy[0];
+    }
+    expect_equal(copy[1]["a"][0], 2);
+    expect_equal(copy.as<json_array>().size(), 2ul);
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<3>() /* file */
+  {
+    json_map const eager{ json_file{ "test/json/map.json" } };
+    json_map const lazy{ json_file{ "test/json/map.json" }, json_lazy{} };
+    expect_equal(lazy, eager);
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<4>() /* empty */
+  {
+    expect(json_map{ json_data{ "{}" }, json_lazy{} }.empty());
+    expect(json_array{ json_data{ "" }, json_lazy{} }.empty());
+    json_array const arr{ json_data{ "[[],{}]" }, json_lazy{} };
+    expect(arr[0].as<json_array>().empty());
+    expect(arr[1].as<json_map>().empty());
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<5>() /* reading from several threads */
+  {
+    json_map const eager{ json_data{ jeayeson::lazy_json } };
+    for(std::size_t run{}; run < 50; ++run)
+    {
+      json_map const lazy{ json_data{ jeayeson::lazy_json }, json_lazy{} };
+      std::atomic<std::size_t> wrong{};
+      std::vector<std::thread> threads;
+      for(std::size_t t{}; t < 4; ++t)
+      {
+        threads.emplace_back([&]
+        {
+          auto const &server(lazy.get<json_array>("servers")[0].as<json_map>());
+          if(server.get<json_array>("ports")[1] != 443 ||
+             lazy.get_for_path<json_array>("limits.deep.deeper")[0] != "x" ||
+             lazy != eager)
+          { ++wrong; }
+        });
+      }
+      for(auto &t : threads)
+      { t.join(); }
+      expect_equal(wrong.load(), 0ul);
+    }
+  }
+
+  template <> template <>
+  void jeayeson::lazy_group::test<6>() /* copies are independent */
+  {
+    json_array const lazy{ json_data{ "[[1,2],[3]]" }, json_lazy{} };
+    expect_equal(lazy[0].as<json_array>()[0], 1);
+
+    json_value first(lazy[0]), second(lazy[1]);
+    first[0] = 5;
+    second.push_back(4);
+    expect_equal(first[0], 5);
+    expect_equal(second.as<json_array>().size(), 2ul);
+    expect_equal(lazy[0].as<json_array>()[0], 1);
+    expect_equal(lazy[1].as<json_array>().size(), 1ul);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/lines.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct lines_test{};
+  using lines_group = jest::group<lines_test>;
+  static lines_group const lines_obj{ "lines" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::lines_group::test<0>() /* records */
+  {
+    json_lines const lines
+    {
+      json_data
+      {
+        "{\"a\":1,\"b\":[true,null]}\n"
+        "\n"
+        "[1,2.5,\"x\\ny\"]\r\n"
+        "\"str\"\n"
+        "42\n"
+        "{}"
+      }
+    };
+    auto const records(lines.get(1));
+    expect_equal(records.size(), 5ul);
+    expect_equal(records[0], json_map{ R"raw({"a":1,"b":[true,null]})raw" });
+    expect_equal(records[1].as<json_array>()[2], "x\ny");
+    expect_equal(records[2], "str");
+    expect_equal(records[3], 42);
+    expect(records[4].as<json_map>().empty());
+  }
+
+  template <> template <>
+  void jeayeson::lines_group::test<1>() /* order across chunks and threads */
+  {
+    std::string json;
+    std::size_t const count{ 100000 };
+    for(std::size_t i{}; i < count; ++i)
+    {
+      json += R"raw({"i":)raw" + std::to_string(i) +
+              R"raw(,"pad":"...................................."})raw" "\n";
+    }
+    expect(json.size() > 4 * json_lines::chunk_size);
+
+    json_lines const lines{ json_span{ json.data(), json.size() } };
+    for(std::size_t const threads : { 1, 2, 4, 7 })
+    {
+      std::size_t seen{};
+      lines.for_each([&](json_value &record)
+      {
+        expect_equal(record.as<json_map>().get<json_int>("i"), static_cast<json_int>(seen));
+        ++seen;
+      }, threads);
+      expect_equal(seen, count);
+    }
+  }
+
+  template <> template <>
+  void jeayeson::lines_group::test<2>() /* errors */
+  {
+    std::string json;
+    for(std::size_t i{}; i < 50000; ++i)
+    { json += "[[[[[[[[]]]]]]]]\n"; }
+    json += std::string(json_map::parser_t::max_depth + 1, '[') + "\n";
+    for(std::size_t i{}; i < 50000; ++i)
+    { json += "[[[[[[[[]]]]]]]]\n"; }
+
+    json_lines const lines{ json_data{ json } };
+    expect_exception<std::runtime_error>
+    ([&]{ lines.for_each([](json_value &){}, 4); });
+  }
+
+  template <> template <>
+  void jeayeson::lines_group::test<3>() /* stray closes */
+  {
+    for(std::string const line : { R"raw(}"x":1)raw", R"raw(]"x":1)raw" })
+    {
+      json_lines const lines{ json_data{ "{\"a\":1}\n" + line + "\n" } };
+      expect_exception<std::runtime_error>([&]{ lines.get(1); });
+      expect_exception<std::runtime_error>([&]{ lines.get(4); });
+    }
+  }
+}
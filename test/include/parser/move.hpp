@@ -0,0 +1,146 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/move.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include <utility>
+
+#include "allocations.hpp"
+
+namespace jeayeson
+{
+  struct move_test{};
+  using move_group = jest::group<move_test>;
+  static move_group const move_obj{ "move" };
+}
+
+namespace jest
+{
+  /* The allocations f makes, which depend on the configured types. */
+  template <typename F>
+  std::size_t count_allocations(F &&f)
+  {
+    std::size_t const before{ jeayeson::allocations };
+    f();
+    return jeayeson::allocations - before;
+  }
+
+  template <> template <>
+  void jeayeson::move_group::test<0>() /* one allocation per node */
+  {
+    /* Short keys and strings, so each entry is moved into its node. */
+    std::string const json
+    { R"raw({"a":1,"b":{"c":true,"d":null,"e":{}},"f":"short"})raw" };
+    json_parser p;
+    json_map out;
+    p.parse(json_data{ json }, out);
+
+    std::size_t const parsed
+    { count_allocations([&]{ p.parse(json_span{ json.data(), json.size() }, out); }) };
+    std::size_t const nodes{ count_allocations([&]{ json_map const copy{ out }; }) };
+    expect_equal(parsed, nodes);
+    expect_equal(out.get_for_path<bool>("b.c"), true);
+  }
+
+  template <> template <>
+  void jeayeson::move_group::test<1>() /* moves don't allocate */
+  {
+    std::string const json
+    {
+      R"raw({"first":"a string which is too long for SSO",)raw"
+      R"raw("second":[1,2,3],"third":{"fourth":"another long enough string"}})raw"
+    };
+    json_map m{ json_data{ json } };
+
+    /* At most a box for the map, with compact_variant. */
+    std::size_t const box{ count_allocations([]{ json_value const v(json_map{}); }) };
+    json_map back;
+    std::size_t const moves{ count_allocations([&]
+    {
+      json_map moved{ std::move(m) };
+      json_value val(std::move(moved));
+      json_value other;
+      other = std::move(val);
+      back = std::move(other.as<json_map>());
+    }) };
+    expect_equal(moves, box);
+    expect_equal(back, json_map{ json_data{ json } });
+
+    /* Only what setting an empty string costs, not the long one. */
+    json_map probe{ json_data{ json } };
+    std::size_t const entry{ count_allocations([&]{ probe.set("k", std::string{}); }) };
+    std::string str{ "yet another string which is too long for SSO" };
+    expect_equal(count_allocations([&]{ back.set("k", std::move(str)); }), entry);
+
+    /* Only what pushing an empty map costs, not the whole map. */
+    std::size_t const element
+    { count_allocations([]{ json_array a; a.push_back(json_map{}); }) };
+    json_array arr;
+    expect_equal(count_allocations([&]{ arr.push_back(std::move(back)); }), element);
+    expect_equal(arr[0]["k"], "yet another string which is too long for SSO");
+  }
+
+  template <> template <>
+  void jeayeson::move_group::test<2>() /* merge */
+  {
+    std::string const json
+    {
+      R"raw({"a":"a string which is too long for SSO",)raw"
+      R"raw("b":{"c":"another string which is too long for SSO"}})raw"
+    };
+    json_map m{ { "z", 0 } };
+    json_map other{ json_data{ json } };
+
+    /* Only what merging the same keys with ints costs; the values come
+     * across as they are. */
+    json_map probe{ { "z", 0 } };
+    json_map probe_other{ { "a", 0 }, { "b", 0 } };
+    std::size_t const entries
+    { count_allocations([&]{ probe.merge(std::move(probe_other)); }) };
+    expect_equal(count_allocations([&]{ m.merge(std::move(other)); }), entries);
+    expect(other.empty());
+    expect_equal(m.size(), 3ul);
+    expect_equal(m.get_for_path<std::string>("b.c"), "another string which is too long for SSO");
+
+    json_map const copy{ { "y", "a string which is too long for SSO" } };
+    m.merge(copy);
+    expect_equal(copy.size(), 1ul);
+    expect_equal(m.size(), 4ul);
+  }
+
+  template <> template <>
+  void jeayeson::move_group::test<3>() /* reset doesn't copy */
+  {
+    std::string const json
+    { R"raw({"a":[1,2,3],"b":{"c":"a string which is too long for SSO"}})raw" };
+    json_span const span{ json.data(), json.size() };
+
+    std::size_t const before{ jeayeson::allocations };
+    json_map const fresh{ span };
+    std::size_t const parsed{ jeayeson::allocations - before };
+
+    json_map m{ { "old", 1 } };
+    std::size_t const reset_before{ jeayeson::allocations };
+    m.reset(span);
+    expect_equal(jeayeson::allocations - reset_before, parsed);
+    expect_equal(m, fresh);
+
+    json_array arr;
+    json_array const fresh_arr{ json_data{ "[[1],[2],[3]]" } };
+    std::size_t const arr_before{ jeayeson::allocations };
+    json_array const again{ json_data{ "[[1],[2],[3]]" } };
+    std::size_t const arr_parsed{ jeayeson::allocations - arr_before };
+    std::size_t const arr_reset_before{ jeayeson::allocations };
+    arr.reset(json_data{ "[[1],[2],[3]]" });
+    expect_equal(jeayeson::allocations - arr_reset_before, arr_parsed);
+    expect_equal(arr, fresh_arr);
+    expect_equal(again, fresh_arr);
+  }
+}
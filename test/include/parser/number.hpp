@@ -78,4 +78,54 @@ namespace jest
     expect_almost_equal(arr.get<json_float>(1), 7.07E+15);
     expect_almost_equal(arr.get<json_float>(2), 2.123E-3);
   }
+
+  template <> template <>
+  void jeayeson::number_group::test<4>() /* 64 bit int */
+  {
+    json_array const arr
+    {
+      json_data
+      { R"raw([9223372036854775807, -9223372036854775808, 4294967296])raw" }
+    };
+    expect_equal(arr.get<json_int>(0), std::numeric_limits<json_int>::max());
+    expect_equal(arr.get<json_int>(1), std::numeric_limits<json_int>::min());
+    expect_equal(arr.get<json_int>(2), 4294967296);
+  }
+
+  template <> template <>
+  void jeayeson::number_group::test<5>() /* int overflow */
+  {
+    json_array const arr
+    {
+      json_data
+      { R"raw([9223372036854775808, -12345678901234567890123])raw" }
+    };
+    expect(arr[0].is(json_value::type::real));
+    expect_equal(arr.get<json_float>(0), 9223372036854775808.0);
+    expect(arr[1].is(json_value::type::real));
+    expect_equal(arr.get<json_float>(1), -12345678901234567890123.0);
+  }
+
+  template <> template <>
+  void jeayeson::number_group::test<6>() /* correct rounding */
+  {
+    json_array const arr
+    {
+      json_data
+      {
+        R"raw([0.1, 0.30000000000000004, 1.7976931348623157e308,
+               4.9e-324, 2.2250738585072014e-308, 9007199254740993.0,
+               3.141592653589793238462643383279, 1e-400, 1e400])raw"
+      }
+    };
+    expect_equal(arr.get<json_float>(0), 0.1);
+    expect_equal(arr.get<json_float>(1), 0.30000000000000004);
+    expect_equal(arr.get<json_float>(2), 1.7976931348623157e308);
+    expect_equal(arr.get<json_float>(3), 4.9e-324);
+    expect_equal(arr.get<json_float>(4), 2.2250738585072014e-308);
+    expect_equal(arr.get<json_float>(5), 9007199254740992.0);
+    expect_equal(arr.get<json_float>(6), 3.141592653589793);
+    expect_equal(arr.get<json_float>(7), 0.0);
+    expect_equal(arr.get<json_float>(8), std::numeric_limits<json_float>::infinity());
+  }
 }
@@ -0,0 +1,68 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/parallel.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct parallel_test{};
+  using parallel_group = jest::group<parallel_test>;
+  static parallel_group const parallel_obj{ "parallel" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::parallel_group::test<0>() /* same as serial */
+  {
+    std::string json{ " [" };
+    for(std::size_t i{}; i < 5000; ++i)
+    {
+      json += (i ? "," : "");
+      switch(i % 5)
+      {
+        case 0: json += R"raw({"i":)raw" + std::to_string(i) + R"raw(,"s":"],[{,"})raw"; break;
+        case 1: json += R"raw([1,[2,[3]],{}])raw"; break;
+        case 2: json += R"raw("str\"ing,]")raw"; break;
+        case 3: json += std::to_string(i) + ".5"; break;
+        case 4: json += "null"; break;
+      }
+    }
+    json += "] ";
+
+    json_array const serial{ json_data{ json } };
+    expect_equal(serial.size(), 5000ul);
+    for(std::size_t const threads : { 1, 2, 3, 8 })
+    {
+      json_array const arr{ json_data{ json }, json_parallel{ threads } };
+      expect_equal(arr, serial);
+    }
+  }
+
+  template <> template <>
+  void jeayeson::parallel_group::test<1>() /* small and empty */
+  {
+    expect(json_array{ json_data{ "[]" }, json_parallel{} }.empty());
+    expect(json_array{ json_data{ "" }, json_parallel{} }.empty());
+    expect(json_array{ json_data{ "{}" }, json_parallel{} }.empty());
+
+    json_array const one{ json_data{ R"raw([{"a":[1]}])raw" }, json_parallel{ 4 } };
+    expect_equal(one.size(), 1ul);
+    expect_equal(one[0].as<json_map>().get<json_array>("a")[0], 1);
+  }
+
+  template <> template <>
+  void jeayeson::parallel_group::test<2>() /* too deep */
+  {
+    std::string const json(json_array::parser_t::max_depth + 1, '[');
+    expect_exception<std::runtime_error>
+    ([&]{ json_array{ json_data{ json }, json_parallel{ 2 } }; });
+  }
+}
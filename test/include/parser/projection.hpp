@@ -0,0 +1,88 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/projection.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct projection_test{};
+  using projection_group = jest::group<projection_test>;
+  static projection_group const projection_obj{ "projection" };
+
+  static std::string const projection_json
+  {
+    R"raw({ "id": 7, "skip": { "id": 1, "s": "}]" }, "user": { "name": "jeaye",)raw"
+    R"raw( "tags": [ "a", { "b": 2 } ], "age": 30 }, "k\"ey": true,)raw"
+    R"raw( "meta": { "ts": 1.5, "src": { "host": "h", "port": 80 } } })raw"
+  };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::projection_group::test<0>() /* only the paths */
+  {
+    json_map const m
+    {
+      json_data{ jeayeson::projection_json },
+      json_projection{ { "id", "user.name", "user.tags", "meta.src.port", "k\"ey" } }
+    };
+    json_map const expected{ json_data{ R"raw({ "id": 7, "user": { "name": "jeaye",)raw"
+      R"raw( "tags": [ "a", { "b": 2 } ] }, "k\"ey": true, "meta": { "src": { "port": 80 } } })raw" } };
+    expect_equal(m, expected);
+    expect_equal(m.get_for_path<json_int>("meta.src.port"), 80);
+  }
+
+  template <> template <>
+  void jeayeson::projection_group::test<1>() /* overlapping and missing paths */
+  {
+    json_map const full{ json_data{ jeayeson::projection_json } };
+    json_map const m
+    {
+      json_data{ jeayeson::projection_json },
+      json_projection{ { "meta.src.host", "meta", "user.age.nope", "nope.nope", "id.nope" } }
+    };
+    expect_equal(m.size(), 2ul);
+    expect_equal(m.get<json_map>("meta"), full.get<json_map>("meta"));
+    /* Paths only lead through maps. */
+    expect(m.get<json_map>("user").empty());
+    expect(!m.has("id"));
+
+    expect(json_map{ json_data{ jeayeson::projection_json }, json_projection{} }.empty());
+    expect(json_map{ json_data{ "" }, json_projection{ { "a" } } }.empty());
+  }
+
+  template <> template <>
+  void jeayeson::projection_group::test<2>() /* lines */
+  {
+    std::string const json
+    { "{\"a\":1,\"b\":{\"c\":2,\"d\":3}}\n[1]\n{\"b\":{\"d\":4},\"e\":[]}\n" };
+    auto records
+    (json_lines{ json_data{ json }, json_projection{ { "b.d" } } }.get());
+    expect_equal(records.size(), 3ul);
+    expect_equal(records[0].as<json_map>(), json_map{ json_data{ R"raw({"b":{"d":3}})raw" } });
+    expect_equal(records[1].as<json_array>().size(), 1ul);
+    expect_equal(records[2]["b"]["d"], 4);
+    expect_equal(records[2].as<json_map>().size(), 1ul);
+  }
+
+  template <> template <>
+  void jeayeson::projection_group::test<3>() /* malformed input */
+  {
+    for(std::string const json : { R"raw({"a":}"x":1})raw", R"raw({"a":]"x":1})raw",
+                                   R"raw({"b":}"a":1})raw", R"raw({"a":)raw" })
+    {
+      expect_exception<std::runtime_error>
+      ([&]{ json_map{ json_data{ json }, json_projection{ { "a" } } }; });
+      expect_exception<std::runtime_error>
+      ([&]{ json_map{ json_data{ json }, json_projection{ { "a.b" } } }; });
+    }
+  }
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/push.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include "allocations.hpp"
+
+namespace jeayeson
+{
+  struct push_test{};
+  using push_group = jest::group<push_test>;
+  static push_group const push_obj{ "push" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::push_group::test<0>() /* whole */
+  {
+    json_push_parser p;
+    expect_equal(p.feed(R"raw({"a":[1,2.5,"x"]} [true, null] {})raw"), 3ul);
+    expect_equal(p.size(), 3ul);
+    expect_equal(p.next(), json_map{ R"raw({"a":[1,2.5,"x"]})raw" });
+    expect_equal(p.next(), json_array{ json_data{ "[true, null]" } });
+    expect_equal(p.next(), json_map{});
+    expect(!p.ready());
+  }
+
+  template <> template <>
+  void jeayeson::push_group::test<1>() /* split at every byte */
+  {
+    std::string const json
+    {
+      R"raw({"key\"\\":"val\u00A9\uD83D\uDE0A","n":-12.5e1,"i":42,)raw"
+      R"raw("l":[true,false,null],"s":"a\nb"})raw"
+    };
+    json_map const expected{ json };
+    for(std::size_t split{}; split <= json.size(); ++split)
+    {
+      json_push_parser p;
+      expect_equal(p.feed(json.substr(0, split)), split == json.size() ? 1ul : 0ul);
+      p.feed(json.substr(split));
+      expect_equal(p.size(), 1ul);
+      expect_equal(p.next(), expected);
+    }
+  }
+
+  template <> template <>
+  void jeayeson::push_group::test<2>() /* one byte at a time */
+  {
+    std::string const json{ "[1,\"two\",{\"three\":[3]}]\n[\"\\u0034\"]\n" };
+    json_push_parser p;
+    std::size_t done{};
+    for(auto const c : json)
+    { done += p.feed(std::string(1, c)); }
+    expect_equal(done, 2ul);
+    expect_equal(p.next(), json_array{ json_data{ "[1,\"two\",{\"three\":[3]}]" } });
+    expect_equal(p.next().as<json_array>()[0], "4");
+  }
+
+  template <> template <>
+  void jeayeson::push_group::test<3>() /* scalars */
+  {
+    json_push_parser p;
+    expect_equal(p.feed("\"str\" 12 tr"), 2ul);
+    expect_equal(p.feed("ue 3"), 1ul);
+    expect_equal(p.finish(), 1ul);
+    expect_equal(p.next(), "str");
+    expect_equal(p.next(), 12);
+    expect_equal(p.next(), true);
+    expect_equal(p.next(), 3);
+  }
+
+  template <> template <>
+  void jeayeson::push_group::test<4>() /* too deep */
+  {
+    json_push_parser p;
+    std::string const json(json_push_parser::max_depth + 1, '[');
+    expect_exception<std::runtime_error>([&]{ p.feed(json); });
+
+    p.reset();
+    expect_equal(p.feed("[[1]]"), 1ul);
+  }
+
+  template <> template <>
+  void jeayeson::push_group::test<5>() /* values are moved out, not copied */
+  {
+    json_push_parser p;
+    expect_equal(p.feed(R"raw({"a_rather_long_key_name":["a rather long string value"]})raw"), 1ul);
+
+    std::size_t const before{ jeayeson::allocations };
+    json_value val(p.next());
+    expect_equal(jeayeson::allocations - before, 0ul);
+    expect_equal(val["a_rather_long_key_name"][0], "a rather long string value");
+  }
+}
@@ -0,0 +1,117 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/reuse.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include "allocations.hpp"
+
+namespace jeayeson
+{
+  struct reuse_test{};
+  using reuse_group = jest::group<reuse_test>;
+  static reuse_group const reuse_obj{ "reuse" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::reuse_group::test<0>() /* same as static */
+  {
+    json_parser p;
+    std::string const docs[]
+    {
+      R"raw({"a":[1,2,{"b":"a string which is too long for SSO"}],"c":null})raw",
+      R"raw([true,false,1.5,"x",{}])raw",
+      R"raw({"deeper":{"and":{"deeper":[[[]]]}}})raw",
+      R"raw({})raw"
+    };
+    for(std::size_t n{}; n < 3; ++n)
+    {
+      for(auto const &doc : docs)
+      {
+        if(doc[0] == '{')
+        { expect_equal(p.parse<json_map>(json_data{ doc }), json_map{ json_data{ doc } }); }
+        else
+        { expect_equal(p.parse<json_array>(json_data{ doc }), json_array{ json_data{ doc } }); }
+      }
+    }
+
+    json_value val;
+    p.parse(json_data{ " 42 " }, val);
+    expect_equal(val, 42);
+    p.parse(json_data{ R"raw(, "s")raw" }, val);
+    expect_equal(val, "s");
+    p.shrink();
+    p.parse(json_data{ "[1]" }, val);
+    expect_equal(val[0], 1);
+
+    /* Arrays left open by input which ends early keep what they had. */
+    std::string const cut{ R"raw([1,["two",[3,4)raw" };
+    expect_equal(p.parse<json_array>(json_data{ cut }), json_array{ json_data{ cut } });
+  }
+
+  template <> template <>
+  void jeayeson::reuse_group::test<1>() /* steady state */
+  {
+    /* Keys and strings too long for the small string optimization. */
+    std::string const msg
+    {
+      R"raw({"a_rather_long_key_name_here":"a rather long string value here",)raw"
+      R"raw("list":["another rather long string value","x"],)raw"
+      R"raw("another_rather_long_key_name":{"yet_another_rather_long_key_name":2.5}})raw"
+    };
+    json_parser p;
+    json_map out;
+    p.parse(json_data{ msg }, out);
+
+    std::size_t const before{ jeayeson::allocations };
+    p.parse(json_span{ msg.data(), msg.size() }, out);
+    std::size_t const reused{ jeayeson::allocations - before };
+
+    /* The nodes of the result, and nothing else. */
+    std::size_t const copy_before{ jeayeson::allocations };
+    json_map const copy{ out };
+    std::size_t const nodes{ jeayeson::allocations - copy_before };
+
+    std::size_t const fresh_before{ jeayeson::allocations };
+    out.reset(json_span{ msg.data(), msg.size() });
+    std::size_t const fresh{ jeayeson::allocations - fresh_before };
+
+    expect_equal(out, copy);
+    expect_equal(out.get_for_path<json_float>("another_rather_long_key_name.yet_another_rather_long_key_name"), 2.5);
+    expect_equal(reused, nodes);
+    expect(reused < fresh);
+
+    /* With no nodes to make, nothing is allocated at all. */
+    std::string const empty{ R"raw(  {  }  )raw" };
+    p.parse(json_span{ empty.data(), empty.size() }, out);
+    std::size_t const empty_before{ jeayeson::allocations };
+    p.parse(json_span{ empty.data(), empty.size() }, out);
+    expect_equal(jeayeson::allocations - empty_before, 0ul);
+    expect(out.empty());
+  }
+
+  template <> template <>
+  void jeayeson::reuse_group::test<2>() /* stray closes */
+  {
+    json_parser p;
+    json_value val;
+    p.parse(json_data{ R"raw(]} 5)raw" }, val);
+    expect_equal(val, 5);
+    /* A key isn't a value, so there's none to be found. */
+    p.parse(json_data{ R"raw(}"x":1)raw" }, val);
+    expect(val.is(json_value::type::null));
+    p.parse(json_data{ R"raw(]"x":1)raw" }, val);
+    expect(val.is(json_value::type::null));
+
+    p.parse(json_data{ R"raw({"a":[1]})raw" }, val);
+    expect_equal(val, json_map{ json_data{ R"raw({"a":[1]})raw" } });
+  }
+}
@@ -0,0 +1,65 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/span.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct span_test{};
+  using span_group = jest::group<span_test>;
+  static span_group const span_obj{ "span" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::span_group::test<0>() /* map and array */
+  {
+    std::string const json{ R"raw({"a":[1,"two",true],"b":null})raw" };
+    json_map const map{ json_span{ json.data(), json.size() } };
+    expect_equal(map.size(), 2ul);
+    expect_equal(map.get<json_array>("a")[1], "two");
+    expect(map["b"] == json_null{});
+
+    json_array const arr{ json_span{ json.data() + 5, 14 } };
+    expect_equal(arr.size(), 3ul);
+    expect_equal(arr[0], 1);
+    expect_equal(arr[2], true);
+  }
+
+  template <> template <>
+  void jeayeson::span_group::test<1>() /* no NUL; nothing past size */
+  {
+    /* The bytes after the span would change the result if they were read. */
+    char const buffer[]{ '[', '1', '2', ',', '"', 'x', '"', ']', '3', '4' };
+    json_array const arr{ json_span{ buffer, 8 } };
+    expect_equal(arr.size(), 2ul);
+    expect_equal(arr[0], 12);
+    expect_equal(arr[1], "x");
+
+    json_array const cut{ json_span{ buffer, 2 } };
+    expect_equal(cut.size(), 1ul);
+    expect_equal(cut[0], 1);
+  }
+
+  template <> template <>
+  void jeayeson::span_group::test<2>() /* across blocks */
+  {
+    std::string json{ "[" };
+    for(std::size_t i{}; i < 100; ++i)
+    { json += (i ? "," : "") + std::to_string(i); }
+    json += "]";
+
+    /* Trailing garbage is never looked at. */
+    std::string const padded{ json + "{]\"tru" };
+    json_array const arr{ json_span{ padded.data(), json.size() } };
+    expect_equal(arr, json_array{ json_data{ json } });
+  }
+}
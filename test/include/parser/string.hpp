@@ -0,0 +1,54 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/string.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct string_test{};
+  using string_group = jest::group<string_test>;
+  static string_group const string_obj{ "string" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::string_group::test<0>() /* long runs */
+  {
+    std::string const run(1000, 'x');
+    json_map const map{ R"raw({")raw" + run + R"raw(":")raw" + run + R"raw("})raw" };
+    expect_equal(map.size(), 1ul);
+    expect_equal(map[run], run);
+
+    json_array const arr{ json_data{ R"raw([")raw" + run + R"raw(", ""])raw" } };
+    expect_equal(arr[0], run);
+    expect_equal(arr[1], "");
+  }
+
+  template <> template <>
+  void jeayeson::string_group::test<1>() /* escapes at every offset */
+  {
+    /* Shift the escapes across every position of a 32 byte vector. */
+    for(std::size_t pad{}; pad < 40; ++pad)
+    {
+      std::string const x(pad, 'x');
+      json_array const arr
+      {
+        json_data
+        {
+          R"raw([")raw" + x + R"raw(\n)raw" + x + R"raw(\"\\",)raw"
+          R"raw(")raw" + x + R"raw(©)raw" + x + R"raw("])raw"
+        }
+      };
+      expect_equal(arr[0], x + "\n" + x + R"raw("\)raw");
+      expect_equal(arr[1], x + "©" + x);
+    }
+  }
+}
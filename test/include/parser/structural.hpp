@@ -0,0 +1,77 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/structural.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+namespace jeayeson
+{
+  struct structural_test{};
+  using structural_group = jest::group<structural_test>;
+  static structural_group const structural_obj{ "structural" };
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::structural_group::test<0>() /* structurals within strings */
+  {
+    json_map const map
+    { R"raw({"{[":"]}", "a,b":":,", "c":["{", "}", "[", "]"]})raw" };
+    expect_equal(map.size(), 3ul);
+    expect_equal(map["{["], "]}");
+    expect_equal(map["a,b"], ":,");
+    expect_equal(map.get<json_array>("c").size(), 4ul);
+    expect_equal(map.get<json_array>("c")[3], "]");
+  }
+
+  template <> template <>
+  void jeayeson::structural_group::test<1>() /* escapes across blocks */
+  {
+    /* Shift the backslashes across every position of a 64 byte block. */
+    for(std::size_t pad{}; pad < 70; ++pad)
+    {
+      std::string const json
+      {
+        R"raw({"pad":")raw" + std::string(pad, 'x') +
+        R"raw(\\\"\\", "next":[1, "\"]"]})raw"
+      };
+      json_map const map{ json };
+      expect_equal(map.size(), 2ul);
+      expect_equal(map["pad"], std::string(pad, 'x') + R"raw(\"\)raw");
+      expect_equal(map.get<json_array>("next")[0], 1);
+      expect_equal(map.get<json_array>("next")[1], "\"]");
+    }
+  }
+
+  template <> template <>
+  void jeayeson::structural_group::test<2>() /* long documents */
+  {
+    std::string json{ "[" };
+    for(std::size_t i{}; i < 500; ++i)
+    {
+      json += (i ? ",\n " : "");
+      json += R"raw({"i":)raw" + std::to_string(i) +
+              R"raw(,"s":"v\"al\\ue","n":null,"t":true,"f":false})raw";
+    }
+    json += "]";
+
+    json_array const arr{ json_data{ json } };
+    expect_equal(arr.size(), 500ul);
+    for(std::size_t i{}; i < arr.size(); ++i)
+    {
+      auto const &m(arr[i].as<json_map>());
+      expect_equal(m.get<json_int>("i"), static_cast<json_int>(i));
+      expect_equal(m["s"], R"raw(v"al\ue)raw");
+      expect(m["n"] == json_null{});
+      expect_equal(m["t"], true);
+      expect_equal(m["f"], false);
+    }
+  }
+}
@@ -100,4 +100,47 @@ namespace jest
     expect_equal(arr[1], "😴Ŵ😶");
     expect_equal(arr[2], "😺Ŧ");
   }
+
+  template <> template <>
+  void jeayeson::utf_group::test<5>() /* long runs */
+  {
+    /* Long enough for the vectorized path, and every length around it,
+     * so pairs straddle where it stops. */
+    for(std::size_t n{}; n < 24; ++n)
+    {
+      std::string json{ "[\"" }, expected;
+      for(std::size_t i{}; i < n; ++i)
+      {
+        switch(i % 3)
+        {
+          case 0: json += "\\u6771"; expected += "東"; break;
+          case 1: json += "\\uD83D\\uDE0A"; expected += "😊"; break;
+          case 2: json += "\\u00e9"; expected += "é"; break;
+        }
+      }
+      json += "x\"]";
+      expected += "x";
+      expect_equal(json_array{ json_data{ json } }[0], expected);
+    }
+  }
+
+  template <> template <>
+  void jeayeson::utf_group::test<6>() /* unpaired surrogates and bad hex */
+  {
+    json_array const arr
+    {
+      json_data
+      {
+        R"raw(["\uD83D", "\uDE0Aa", "\uD83D\u0041", "\uD83D\uD83D\uDE0A",
+               "\uZZZZ\u0041", "\u004", "\u0041\n\u0042"])raw"
+      }
+    };
+    expect_equal(arr[0], "\xEF\xBF\xBD");
+    expect_equal(arr[1], "\xEF\xBF\xBD" "a");
+    expect_equal(arr[2], "\xEF\xBF\xBD" "A");
+    expect_equal(arr[3], "\xEF\xBF\xBD" "😊");
+    expect_equal(arr[4], "\xEF\xBF\xBD" "A");
+    expect_equal(arr[5], "u004");
+    expect_equal(arr[6], "A\nB");
+  }
 }
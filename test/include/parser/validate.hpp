@@ -0,0 +1,127 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/parser/validate.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jest/jest.hpp>
+
+#include <random>
+
+namespace jeayeson
+{
+  struct validate_test{};
+  using validate_group = jest::group<validate_test>;
+  static validate_group const validate_obj{ "validate" };
+
+  /* Both implementations, over the whole input padded to blocks. */
+  inline std::vector<bool> validate_all(std::string str)
+  {
+    str.resize((str.size() / 64 + 1) * 64, ' ');
+    std::vector<bool> results;
+
+    detail::utf8::scalar_t scalar;
+    scalar.blocks(str.data(), str.size() / 64);
+    results.push_back(scalar.valid());
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    if(detail::simd::isa() == detail::simd::isa_t::avx2)
+    {
+      detail::utf8::avx2_t vector;
+      vector.blocks(str.data(), str.size() / 64);
+      results.push_back(vector.valid());
+    }
+#endif
+    return results;
+  }
+
+  inline bool validate_agree(std::string const &str, bool const expected)
+  {
+    for(bool const result : validate_all(str))
+    {
+      if(result != expected)
+      { return false; }
+    }
+    return true;
+  }
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::validate_group::test<0>() /* valid */
+  {
+    using jeayeson::validate_agree;
+    std::string const chars[]
+    { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80",
+      "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF", "\xEF\xBF\xBF" };
+    for(auto const &c : chars)
+    {
+      /* Every alignment, so sequences straddle the lanes and blocks. */
+      for(std::size_t offset{}; offset < 70; ++offset)
+      {
+        std::string const str{ std::string(offset, 'x') + c + c };
+        expect(validate_agree(str, true));
+      }
+    }
+  }
+
+  template <> template <>
+  void jeayeson::validate_group::test<1>() /* invalid */
+  {
+    using jeayeson::validate_agree;
+    std::string const bad[]
+    {
+      "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41",
+      "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+      "\xE2\x82", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80",
+      "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF", "\xC3\xA9\xA9"
+    };
+    for(auto const &b : bad)
+    {
+      for(std::size_t offset{}; offset < 70; ++offset)
+      {
+        std::string const str{ std::string(offset, 'x') + b };
+        expect(validate_agree(str, false));
+        /* A partial sequence followed by a whole ASCII block. */
+        expect(validate_agree(str + std::string(130, 'y'), false));
+      }
+    }
+  }
+
+  template <> template <>
+  void jeayeson::validate_group::test<2>() /* implementations agree */
+  {
+    std::mt19937 gen{ 42 };
+    std::uniform_int_distribution<int> byte{ 0x80, 0xFF };
+    std::uniform_int_distribution<int> len{ 0, 200 };
+    for(std::size_t i{}; i < 20000; ++i)
+    {
+      std::string str(len(gen), 'z');
+      for(std::size_t j{}; j < 4 && !str.empty(); ++j)
+      { str[gen() % str.size()] = static_cast<char>(byte(gen)); }
+      auto const results(jeayeson::validate_all(str));
+      expect(results.front() == results.back());
+    }
+  }
+
+  template <> template <>
+  void jeayeson::validate_group::test<3>() /* parsing */
+  {
+    std::string const good{ R"raw({"kéy":"caf)raw" "\xC3\xA9" R"raw(","a":["\xE2\x82\xAC"]})raw" };
+    json_map const m{ json_data{ good }, json_validate{} };
+    expect_equal(m, json_map{ json_data{ good } });
+    expect_equal(m.get<std::string>("k\xC3\xA9y"), "caf\xC3\xA9");
+
+    std::string const bad{ "[\"\xC3\x28\"]" };
+    expect_exception<std::runtime_error>
+    ([&]{ json_array{ json_data{ bad }, json_validate{} }; });
+    expect_exception<std::runtime_error>
+    ([&]{ json_array{ json_span{ bad.data(), bad.size() }, json_validate{} }; });
+    /* Not asked for, not checked. */
+    expect_equal(json_array{ json_data{ bad } }.size(), 1ul);
+  }
+}
@@ -0,0 +1,117 @@
+/*
+  Copyright © 2015 Jesse 'Jeaye' Wilkerson
+  See licensing at:
+    http://opensource.org/licenses/BSD-3-Clause
+
+  File: test/include/value/compact.hpp
+  Author: Jesse 'Jeaye' Wilkerson
+*/
+
+#include <jeayeson/jeayeson.hpp>
+#include <jeayeson/compact_variant.hpp>
+#include <jeayeson/arena.hpp>
+#include <jest/jest.hpp>
+
+#include <string>
+#include <sstream>
+#include <utility>
+#include <type_traits>
+
+#include "parser/allocations.hpp"
+
+namespace jeayeson
+{
+  struct value_compact_test{};
+  using value_compact_group = jest::group<value_compact_test>;
+  static value_compact_group const value_compact_obj{ "value compact" };
+
+  using compact_t = compact_variant
+  <value::null_t, json_int, json_float, bool, std::string, json_map, json_array>;
+}
+
+namespace jest
+{
+  template <> template <>
+  void jeayeson::value_compact_group::test<0>() /* layout */
+  {
+    expect_equal(sizeof(jeayeson::compact_t), 2 * sizeof(void*));
+
+    jeayeson::compact_t const null;
+    expect_equal(null.which(), 0);
+    jeayeson::compact_t const i{ json_int{ 42 } };
+    expect_equal(i.which(), 1);
+    expect_equal(i.get<json_int>(), 42);
+    jeayeson::compact_t const f{ json_float{ 4.5 } };
+    expect_equal(f.get<json_float>(), 4.5);
+    jeayeson::compact_t const b{ true };
+    expect_equal(b.which(), 3);
+    expect_equal(b.get<bool>(), true);
+    jeayeson::compact_t const s{ std::string{ "a string which is too long for SSO" } };
+    expect_equal(s.get<std::string>(), "a string which is too long for SSO");
+
+    expect(i.get_if<json_float>() == nullptr);
+    expect_exception<boost::bad_get>([&]{ i.get<std::string>(); });
+  }
+
+  template <> template <>
+  void jeayeson::value_compact_group::test<1>() /* copy, move and assign */
+  {
+    jeayeson::compact_t m{ json_map{ { "a", 1 }, { "b", "two" } } };
+    jeayeson::compact_t copy{ m };
+    expect(copy == m);
+    copy.get<json_map>().set("c", 3);
+    expect(copy != m);
+    expect_equal(m.get<json_map>().size(), 2ul);
+
+    jeayeson::compact_t moved{ std::move(copy) };
+    expect_equal(moved.get<json_map>().size(), 3ul);
+    expect_equal(copy.which(), 0);
+
+    /* Across types, and within one. */
+    moved = std::string{ "str" };
+    expect_equal(moved.get<std::string>(), "str");
+    std::string const * const before{ moved.get_if<std::string>() };
+    moved = std::string{ "other" };
+    expect_equal(moved.get_if<std::string>(), before);
+    moved = json_int{ 7 };
+    expect_equal(moved.get<json_int>(), 7);
+    moved = m;
+    expect(moved == m);
+    moved = moved;
+    expect(moved == m);
+  }
+
+  template <> template <>
+  void jeayeson::value_compact_group::test<2>() /* print */
+  {
+    std::stringstream ss;
+    ss << jeayeson::compact_t{ json_int{ 3 } } << " "
+       << jeayeson::compact_t{ json_array{ 1, 2 } } << " "
+       << jeayeson::compact_t{};
+    expect_equal(ss.str(), "3 [1,2] null");
+  }
+
+  template <> template <>
+  void jeayeson::value_compact_group::test<3>() /* boxes come from allocator_t */
+  {
+    bool constexpr const in_arena
+    {
+      std::is_same
+      <jeayeson::detail::allocator<int>, jeayeson::arena_allocator<int>>::value
+    };
+
+    jeayeson::arena a;
+    a.allocate(1, 1); /* Its first block. */
+    jeayeson::compact_t boxed;
+    {
+      jeayeson::arena::scope const s{ a };
+      std::size_t const before{ jeayeson::allocations };
+      boxed = json_map{};
+      expect_equal(jeayeson::allocations - before, in_arena ? 0ul : 1ul);
+    }
+
+    /* Freed outside the scope, back to where it came from. */
+    boxed = json_int{ 1 };
+    expect_equal(boxed.get<json_int>(), 1);
+  }
+}
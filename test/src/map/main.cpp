@@ -18,6 +18,11 @@
 #include "map/clear.hpp"
 #include "map/delim.hpp"
 #include "map/has.hpp"
+#include "map/intern.hpp"
+#include "map/flat.hpp"
+#include "map/swiss.hpp"
+#include "map/view.hpp"
+#include "map/key.hpp"
 
 int main()
 {
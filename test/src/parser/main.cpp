@@ -13,6 +13,23 @@
 #include "parser/escape.hpp"
 #include "parser/number.hpp"
 #include "parser/utf.hpp"
+#include "parser/structural.hpp"
+#include "parser/depth.hpp"
+#include "parser/string.hpp"
+#include "parser/span.hpp"
+#include "parser/file.hpp"
+#include "parser/push.hpp"
+#include "parser/handler.hpp"
+#include "parser/cursor.hpp"
+#include "parser/lines.hpp"
+#include "parser/parallel.hpp"
+#include "parser/lazy.hpp"
+#include "parser/bind.hpp"
+#include "parser/projection.hpp"
+#include "parser/validate.hpp"
+#include "parser/reuse.hpp"
+#include "parser/move.hpp"
+#include "parser/arena.hpp"
 
 int main()
 {
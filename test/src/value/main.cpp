@@ -11,6 +11,7 @@
 #include <jest/jest.hpp>
 
 #include "value/ctor.hpp"
+#include "value/compact.hpp"
 
 int main()
 {